@@ -34,6 +34,7 @@
 #include "fast-dtoa.h"
 #include "fixed-dtoa.h"
 #include "ieee.h"
+#include "schubfach-dtoa.h"
 #include "strtod.h"
 #include "utils.h"
 
@@ -385,11 +386,14 @@ void DoubleToStringConverter::DoubleToAscii(double v,
     return;
   }
 
+  if (mode == SHORTEST) {
+    // Always succeeds, and is faster than FastDtoa even where that does.
+    SchubfachDtoa(v, vector, length, point);
+    return;
+  }
+
   bool fast_worked;
   switch (mode) {
-    case SHORTEST:
-      fast_worked = FastDtoa(v, FAST_DTOA_SHORTEST, 0, vector, length, point);
-      break;
     case SHORTEST_SINGLE:
       fast_worked = FastDtoa(v, FAST_DTOA_SHORTEST_SINGLE, 0,
                              vector, length, point);
@@ -0,0 +1,809 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "schubfach-dtoa.h"
+
+#include "ieee.h"
+
+namespace double_conversion {
+
+// The powers of ten from 10^-292 to 10^326, each as the 128-bit g with
+// 2^127 <= g < 2^128 such that 10^k <= g * 2^e for the smallest possible e:
+// the high 64 bits, then the low 64 bits.
+static const int kSchubfachMinDecimalPower = -292;
+static const uint64_t kSchubfachPowersOfTen[][2] = {
+  {UINT64_2PART_C(0xff77b1fc, bebcdc4f), UINT64_2PART_C(0x25e8e89c, 13bb0f7b)},  // 10^-292
+  {UINT64_2PART_C(0x9faacf3d, f73609b1), UINT64_2PART_C(0x77b19161, 8c54e9ad)},  // 10^-291
+  {UINT64_2PART_C(0xc795830d, 75038c1d), UINT64_2PART_C(0xd59df5b9, ef6a2418)},  // 10^-290
+  {UINT64_2PART_C(0xf97ae3d0, d2446f25), UINT64_2PART_C(0x4b057328, 6b44ad1e)},  // 10^-289
+  {UINT64_2PART_C(0x9becce62, 836ac577), UINT64_2PART_C(0x4ee367f9, 430aec33)},  // 10^-288
+  {UINT64_2PART_C(0xc2e801fb, 244576d5), UINT64_2PART_C(0x229c41f7, 93cda740)},  // 10^-287
+  {UINT64_2PART_C(0xf3a20279, ed56d48a), UINT64_2PART_C(0x6b435275, 78c11110)},  // 10^-286
+  {UINT64_2PART_C(0x9845418c, 345644d6), UINT64_2PART_C(0x830a1389, 6b78aaaa)},  // 10^-285
+  {UINT64_2PART_C(0xbe5691ef, 416bd60c), UINT64_2PART_C(0x23cc986b, c656d554)},  // 10^-284
+  {UINT64_2PART_C(0xedec366b, 11c6cb8f), UINT64_2PART_C(0x2cbfbe86, b7ec8aa9)},  // 10^-283
+  {UINT64_2PART_C(0x94b3a202, eb1c3f39), UINT64_2PART_C(0x7bf7d714, 32f3d6aa)},  // 10^-282
+  {UINT64_2PART_C(0xb9e08a83, a5e34f07), UINT64_2PART_C(0xdaf5ccd9, 3fb0cc54)},  // 10^-281
+  {UINT64_2PART_C(0xe858ad24, 8f5c22c9), UINT64_2PART_C(0xd1b3400f, 8f9cff69)},  // 10^-280
+  {UINT64_2PART_C(0x91376c36, d99995be), UINT64_2PART_C(0x23100809, b9c21fa2)},  // 10^-279
+  {UINT64_2PART_C(0xb5854744, 8ffffb2d), UINT64_2PART_C(0xabd40a0c, 2832a78b)},  // 10^-278
+  {UINT64_2PART_C(0xe2e69915, b3fff9f9), UINT64_2PART_C(0x16c90c8f, 323f516d)},  // 10^-277
+  {UINT64_2PART_C(0x8dd01fad, 907ffc3b), UINT64_2PART_C(0xae3da7d9, 7f6792e4)},  // 10^-276
+  {UINT64_2PART_C(0xb1442798, f49ffb4a), UINT64_2PART_C(0x99cd11cf, df41779d)},  // 10^-275
+  {UINT64_2PART_C(0xdd95317f, 31c7fa1d), UINT64_2PART_C(0x40405643, d711d584)},  // 10^-274
+  {UINT64_2PART_C(0x8a7d3eef, 7f1cfc52), UINT64_2PART_C(0x482835ea, 666b2573)},  // 10^-273
+  {UINT64_2PART_C(0xad1c8eab, 5ee43b66), UINT64_2PART_C(0xda324365, 0005eed0)},  // 10^-272
+  {UINT64_2PART_C(0xd863b256, 369d4a40), UINT64_2PART_C(0x90bed43e, 40076a83)},  // 10^-271
+  {UINT64_2PART_C(0x873e4f75, e2224e68), UINT64_2PART_C(0x5a7744a6, e804a292)},  // 10^-270
+  {UINT64_2PART_C(0xa90de353, 5aaae202), UINT64_2PART_C(0x711515d0, a205cb37)},  // 10^-269
+  {UINT64_2PART_C(0xd3515c28, 31559a83), UINT64_2PART_C(0x0d5a5b44, ca873e04)},  // 10^-268
+  {UINT64_2PART_C(0x8412d999, 1ed58091), UINT64_2PART_C(0xe858790a, fe9486c3)},  // 10^-267
+  {UINT64_2PART_C(0xa5178fff, 668ae0b6), UINT64_2PART_C(0x626e974d, be39a873)},  // 10^-266
+  {UINT64_2PART_C(0xce5d73ff, 402d98e3), UINT64_2PART_C(0xfb0a3d21, 2dc81290)},  // 10^-265
+  {UINT64_2PART_C(0x80fa687f, 881c7f8e), UINT64_2PART_C(0x7ce66634, bc9d0b9a)},  // 10^-264
+  {UINT64_2PART_C(0xa139029f, 6a239f72), UINT64_2PART_C(0x1c1fffc1, ebc44e81)},  // 10^-263
+  {UINT64_2PART_C(0xc9874347, 44ac874e), UINT64_2PART_C(0xa327ffb2, 66b56221)},  // 10^-262
+  {UINT64_2PART_C(0xfbe91419, 15d7a922), UINT64_2PART_C(0x4bf1ff9f, 0062baa9)},  // 10^-261
+  {UINT64_2PART_C(0x9d71ac8f, ada6c9b5), UINT64_2PART_C(0x6f773fc3, 603db4aa)},  // 10^-260
+  {UINT64_2PART_C(0xc4ce17b3, 99107c22), UINT64_2PART_C(0xcb550fb4, 384d21d4)},  // 10^-259
+  {UINT64_2PART_C(0xf6019da0, 7f549b2b), UINT64_2PART_C(0x7e2a53a1, 46606a49)},  // 10^-258
+  {UINT64_2PART_C(0x99c10284, 4f94e0fb), UINT64_2PART_C(0x2eda7444, cbfc426e)},  // 10^-257
+  {UINT64_2PART_C(0xc0314325, 637a1939), UINT64_2PART_C(0xfa911155, fefb5309)},  // 10^-256
+  {UINT64_2PART_C(0xf03d93ee, bc589f88), UINT64_2PART_C(0x793555ab, 7eba27cb)},  // 10^-255
+  {UINT64_2PART_C(0x96267c75, 35b763b5), UINT64_2PART_C(0x4bc1558b, 2f3458df)},  // 10^-254
+  {UINT64_2PART_C(0xbbb01b92, 83253ca2), UINT64_2PART_C(0x9eb1aaed, fb016f17)},  // 10^-253
+  {UINT64_2PART_C(0xea9c2277, 23ee8bcb), UINT64_2PART_C(0x465e15a9, 79c1cadd)},  // 10^-252
+  {UINT64_2PART_C(0x92a1958a, 7675175f), UINT64_2PART_C(0x0bfacd89, ec191eca)},  // 10^-251
+  {UINT64_2PART_C(0xb749faed, 14125d36), UINT64_2PART_C(0xcef980ec, 671f667c)},  // 10^-250
+  {UINT64_2PART_C(0xe51c79a8, 5916f484), UINT64_2PART_C(0x82b7e127, 80e7401b)},  // 10^-249
+  {UINT64_2PART_C(0x8f31cc09, 37ae58d2), UINT64_2PART_C(0xd1b2ecb8, b0908811)},  // 10^-248
+  {UINT64_2PART_C(0xb2fe3f0b, 8599ef07), UINT64_2PART_C(0x861fa7e6, dcb4aa16)},  // 10^-247
+  {UINT64_2PART_C(0xdfbdcece, 67006ac9), UINT64_2PART_C(0x67a791e0, 93e1d49b)},  // 10^-246
+  {UINT64_2PART_C(0x8bd6a141, 006042bd), UINT64_2PART_C(0xe0c8bb2c, 5c6d24e1)},  // 10^-245
+  {UINT64_2PART_C(0xaecc4991, 4078536d), UINT64_2PART_C(0x58fae9f7, 73886e19)},  // 10^-244
+  {UINT64_2PART_C(0xda7f5bf5, 90966848), UINT64_2PART_C(0xaf39a475, 506a899f)},  // 10^-243
+  {UINT64_2PART_C(0x888f9979, 7a5e012d), UINT64_2PART_C(0x6d8406c9, 52429604)},  // 10^-242
+  {UINT64_2PART_C(0xaab37fd7, d8f58178), UINT64_2PART_C(0xc8e5087b, a6d33b84)},  // 10^-241
+  {UINT64_2PART_C(0xd5605fcd, cf32e1d6), UINT64_2PART_C(0xfb1e4a9a, 90880a65)},  // 10^-240
+  {UINT64_2PART_C(0x855c3be0, a17fcd26), UINT64_2PART_C(0x5cf2eea0, 9a550680)},  // 10^-239
+  {UINT64_2PART_C(0xa6b34ad8, c9dfc06f), UINT64_2PART_C(0xf42faa48, c0ea481f)},  // 10^-238
+  {UINT64_2PART_C(0xd0601d8e, fc57b08b), UINT64_2PART_C(0xf13b94da, f124da27)},  // 10^-237
+  {UINT64_2PART_C(0x823c1279, 5db6ce57), UINT64_2PART_C(0x76c53d08, d6b70859)},  // 10^-236
+  {UINT64_2PART_C(0xa2cb1717, b52481ed), UINT64_2PART_C(0x54768c4b, 0c64ca6f)},  // 10^-235
+  {UINT64_2PART_C(0xcb7ddcdd, a26da268), UINT64_2PART_C(0xa9942f5d, cf7dfd0a)},  // 10^-234
+  {UINT64_2PART_C(0xfe5d5415, 0b090b02), UINT64_2PART_C(0xd3f93b35, 435d7c4d)},  // 10^-233
+  {UINT64_2PART_C(0x9efa548d, 26e5a6e1), UINT64_2PART_C(0xc47bc501, 4a1a6db0)},  // 10^-232
+  {UINT64_2PART_C(0xc6b8e9b0, 709f109a), UINT64_2PART_C(0x359ab641, 9ca1091c)},  // 10^-231
+  {UINT64_2PART_C(0xf867241c, 8cc6d4c0), UINT64_2PART_C(0xc30163d2, 03c94b63)},  // 10^-230
+  {UINT64_2PART_C(0x9b407691, d7fc44f8), UINT64_2PART_C(0x79e0de63, 425dcf1e)},  // 10^-229
+  {UINT64_2PART_C(0xc2109436, 4dfb5636), UINT64_2PART_C(0x985915fc, 12f542e5)},  // 10^-228
+  {UINT64_2PART_C(0xf294b943, e17a2bc4), UINT64_2PART_C(0x3e6f5b7b, 17b2939e)},  // 10^-227
+  {UINT64_2PART_C(0x979cf3ca, 6cec5b5a), UINT64_2PART_C(0xa705992c, eecf9c43)},  // 10^-226
+  {UINT64_2PART_C(0xbd8430bd, 08277231), UINT64_2PART_C(0x50c6ff78, 2a838354)},  // 10^-225
+  {UINT64_2PART_C(0xece53cec, 4a314ebd), UINT64_2PART_C(0xa4f8bf56, 35246429)},  // 10^-224
+  {UINT64_2PART_C(0x940f4613, ae5ed136), UINT64_2PART_C(0x871b7795, e136be9a)},  // 10^-223
+  {UINT64_2PART_C(0xb9131798, 99f68584), UINT64_2PART_C(0x28e2557b, 59846e40)},  // 10^-222
+  {UINT64_2PART_C(0xe757dd7e, c07426e5), UINT64_2PART_C(0x331aeada, 2fe589d0)},  // 10^-221
+  {UINT64_2PART_C(0x9096ea6f, 3848984f), UINT64_2PART_C(0x3ff0d2c8, 5def7622)},  // 10^-220
+  {UINT64_2PART_C(0xb4bca50b, 065abe63), UINT64_2PART_C(0x0fed077a, 756b53aa)},  // 10^-219
+  {UINT64_2PART_C(0xe1ebce4d, c7f16dfb), UINT64_2PART_C(0xd3e84959, 12c62895)},  // 10^-218
+  {UINT64_2PART_C(0x8d3360f0, 9cf6e4bd), UINT64_2PART_C(0x64712dd7, abbbd95d)},  // 10^-217
+  {UINT64_2PART_C(0xb080392c, c4349dec), UINT64_2PART_C(0xbd8d794d, 96aacfb4)},  // 10^-216
+  {UINT64_2PART_C(0xdca04777, f541c567), UINT64_2PART_C(0xecf0d7a0, fc5583a1)},  // 10^-215
+  {UINT64_2PART_C(0x89e42caa, f9491b60), UINT64_2PART_C(0xf41686c4, 9db57245)},  // 10^-214
+  {UINT64_2PART_C(0xac5d37d5, b79b6239), UINT64_2PART_C(0x311c2875, c522ced6)},  // 10^-213
+  {UINT64_2PART_C(0xd77485cb, 25823ac7), UINT64_2PART_C(0x7d633293, 366b828c)},  // 10^-212
+  {UINT64_2PART_C(0x86a8d39e, f77164bc), UINT64_2PART_C(0xae5dff9c, 02033198)},  // 10^-211
+  {UINT64_2PART_C(0xa8530886, b54dbdeb), UINT64_2PART_C(0xd9f57f83, 0283fdfd)},  // 10^-210
+  {UINT64_2PART_C(0xd267caa8, 62a12d66), UINT64_2PART_C(0xd072df63, c324fd7c)},  // 10^-209
+  {UINT64_2PART_C(0x8380dea9, 3da4bc60), UINT64_2PART_C(0x4247cb9e, 59f71e6e)},  // 10^-208
+  {UINT64_2PART_C(0xa4611653, 8d0deb78), UINT64_2PART_C(0x52d9be85, f074e609)},  // 10^-207
+  {UINT64_2PART_C(0xcd795be8, 70516656), UINT64_2PART_C(0x67902e27, 6c921f8c)},  // 10^-206
+  {UINT64_2PART_C(0x806bd971, 4632dff6), UINT64_2PART_C(0x00ba1cd8, a3db53b7)},  // 10^-205
+  {UINT64_2PART_C(0xa086cfcd, 97bf97f3), UINT64_2PART_C(0x80e8a40e, ccd228a5)},  // 10^-204
+  {UINT64_2PART_C(0xc8a883c0, fdaf7df0), UINT64_2PART_C(0x6122cd12, 8006b2ce)},  // 10^-203
+  {UINT64_2PART_C(0xfad2a4b1, 3d1b5d6c), UINT64_2PART_C(0x796b8057, 20085f82)},  // 10^-202
+  {UINT64_2PART_C(0x9cc3a6ee, c6311a63), UINT64_2PART_C(0xcbe33036, 74053bb1)},  // 10^-201
+  {UINT64_2PART_C(0xc3f490aa, 77bd60fc), UINT64_2PART_C(0xbedbfc44, 11068a9d)},  // 10^-200
+  {UINT64_2PART_C(0xf4f1b4d5, 15acb93b), UINT64_2PART_C(0xee92fb55, 15482d45)},  // 10^-199
+  {UINT64_2PART_C(0x99171105, 2d8bf3c5), UINT64_2PART_C(0x751bdd15, 2d4d1c4b)},  // 10^-198
+  {UINT64_2PART_C(0xbf5cd546, 78eef0b6), UINT64_2PART_C(0xd262d45a, 78a0635e)},  // 10^-197
+  {UINT64_2PART_C(0xef340a98, 172aace4), UINT64_2PART_C(0x86fb8971, 16c87c35)},  // 10^-196
+  {UINT64_2PART_C(0x9580869f, 0e7aac0e), UINT64_2PART_C(0xd45d35e6, ae3d4da1)},  // 10^-195
+  {UINT64_2PART_C(0xbae0a846, d2195712), UINT64_2PART_C(0x89748360, 59cca10a)},  // 10^-194
+  {UINT64_2PART_C(0xe998d258, 869facd7), UINT64_2PART_C(0x2bd1a438, 703fc94c)},  // 10^-193
+  {UINT64_2PART_C(0x91ff8377, 5423cc06), UINT64_2PART_C(0x7b6306a3, 4627ddd0)},  // 10^-192
+  {UINT64_2PART_C(0xb67f6455, 292cbf08), UINT64_2PART_C(0x1a3bc84c, 17b1d543)},  // 10^-191
+  {UINT64_2PART_C(0xe41f3d6a, 7377eeca), UINT64_2PART_C(0x20caba5f, 1d9e4a94)},  // 10^-190
+  {UINT64_2PART_C(0x8e938662, 882af53e), UINT64_2PART_C(0x547eb47b, 7282ee9d)},  // 10^-189
+  {UINT64_2PART_C(0xb23867fb, 2a35b28d), UINT64_2PART_C(0xe99e619a, 4f23aa44)},  // 10^-188
+  {UINT64_2PART_C(0xdec681f9, f4c31f31), UINT64_2PART_C(0x6405fa00, e2ec94d5)},  // 10^-187
+  {UINT64_2PART_C(0x8b3c113c, 38f9f37e), UINT64_2PART_C(0xde83bc40, 8dd3dd05)},  // 10^-186
+  {UINT64_2PART_C(0xae0b158b, 4738705e), UINT64_2PART_C(0x9624ab50, b148d446)},  // 10^-185
+  {UINT64_2PART_C(0xd98ddaee, 19068c76), UINT64_2PART_C(0x3badd624, dd9b0958)},  // 10^-184
+  {UINT64_2PART_C(0x87f8a8d4, cfa417c9), UINT64_2PART_C(0xe54ca5d7, 0a80e5d7)},  // 10^-183
+  {UINT64_2PART_C(0xa9f6d30a, 038d1dbc), UINT64_2PART_C(0x5e9fcf4c, cd211f4d)},  // 10^-182
+  {UINT64_2PART_C(0xd47487cc, 8470652b), UINT64_2PART_C(0x7647c320, 00696720)},  // 10^-181
+  {UINT64_2PART_C(0x84c8d4df, d2c63f3b), UINT64_2PART_C(0x29ecd9f4, 0041e074)},  // 10^-180
+  {UINT64_2PART_C(0xa5fb0a17, c777cf09), UINT64_2PART_C(0xf4681071, 00525891)},  // 10^-179
+  {UINT64_2PART_C(0xcf79cc9d, b955c2cc), UINT64_2PART_C(0x7182148d, 4066eeb5)},  // 10^-178
+  {UINT64_2PART_C(0x81ac1fe2, 93d599bf), UINT64_2PART_C(0xc6f14cd8, 48405531)},  // 10^-177
+  {UINT64_2PART_C(0xa21727db, 38cb002f), UINT64_2PART_C(0xb8ada00e, 5a506a7d)},  // 10^-176
+  {UINT64_2PART_C(0xca9cf1d2, 06fdc03b), UINT64_2PART_C(0xa6d90811, f0e4851d)},  // 10^-175
+  {UINT64_2PART_C(0xfd442e46, 88bd304a), UINT64_2PART_C(0x908f4a16, 6d1da664)},  // 10^-174
+  {UINT64_2PART_C(0x9e4a9cec, 15763e2e), UINT64_2PART_C(0x9a598e4e, 043287ff)},  // 10^-173
+  {UINT64_2PART_C(0xc5dd4427, 1ad3cdba), UINT64_2PART_C(0x40eff1e1, 853f29fe)},  // 10^-172
+  {UINT64_2PART_C(0xf7549530, e188c128), UINT64_2PART_C(0xd12bee59, e68ef47d)},  // 10^-171
+  {UINT64_2PART_C(0x9a94dd3e, 8cf578b9), UINT64_2PART_C(0x82bb74f8, 301958cf)},  // 10^-170
+  {UINT64_2PART_C(0xc13a148e, 3032d6e7), UINT64_2PART_C(0xe36a5236, 3c1faf02)},  // 10^-169
+  {UINT64_2PART_C(0xf18899b1, bc3f8ca1), UINT64_2PART_C(0xdc44e6c3, cb279ac2)},  // 10^-168
+  {UINT64_2PART_C(0x96f5600f, 15a7b7e5), UINT64_2PART_C(0x29ab103a, 5ef8c0ba)},  // 10^-167
+  {UINT64_2PART_C(0xbcb2b812, db11a5de), UINT64_2PART_C(0x7415d448, f6b6f0e8)},  // 10^-166
+  {UINT64_2PART_C(0xebdf6617, 91d60f56), UINT64_2PART_C(0x111b495b, 3464ad22)},  // 10^-165
+  {UINT64_2PART_C(0x936b9fce, bb25c995), UINT64_2PART_C(0xcab10dd9, 00beec35)},  // 10^-164
+  {UINT64_2PART_C(0xb84687c2, 69ef3bfb), UINT64_2PART_C(0x3d5d514f, 40eea743)},  // 10^-163
+  {UINT64_2PART_C(0xe65829b3, 046b0afa), UINT64_2PART_C(0x0cb4a5a3, 112a5113)},  // 10^-162
+  {UINT64_2PART_C(0x8ff71a0f, e2c2e6dc), UINT64_2PART_C(0x47f0e785, eaba72ac)},  // 10^-161
+  {UINT64_2PART_C(0xb3f4e093, db73a093), UINT64_2PART_C(0x59ed2167, 65690f57)},  // 10^-160
+  {UINT64_2PART_C(0xe0f218b8, d25088b8), UINT64_2PART_C(0x306869c1, 3ec3532d)},  // 10^-159
+  {UINT64_2PART_C(0x8c974f73, 83725573), UINT64_2PART_C(0x1e414218, c73a13fc)},  // 10^-158
+  {UINT64_2PART_C(0xafbd2350, 644eeacf), UINT64_2PART_C(0xe5d1929e, f90898fb)},  // 10^-157
+  {UINT64_2PART_C(0xdbac6c24, 7d62a583), UINT64_2PART_C(0xdf45f746, b74abf3a)},  // 10^-156
+  {UINT64_2PART_C(0x894bc396, ce5da772), UINT64_2PART_C(0x6b8bba8c, 328eb784)},  // 10^-155
+  {UINT64_2PART_C(0xab9eb47c, 81f5114f), UINT64_2PART_C(0x066ea92f, 3f326565)},  // 10^-154
+  {UINT64_2PART_C(0xd686619b, a27255a2), UINT64_2PART_C(0xc80a537b, 0efefebe)},  // 10^-153
+  {UINT64_2PART_C(0x8613fd01, 45877585), UINT64_2PART_C(0xbd06742c, e95f5f37)},  // 10^-152
+  {UINT64_2PART_C(0xa798fc41, 96e952e7), UINT64_2PART_C(0x2c481138, 23b73705)},  // 10^-151
+  {UINT64_2PART_C(0xd17f3b51, fca3a7a0), UINT64_2PART_C(0xf75a1586, 2ca504c6)},  // 10^-150
+  {UINT64_2PART_C(0x82ef8513, 3de648c4), UINT64_2PART_C(0x9a984d73, dbe722fc)},  // 10^-149
+  {UINT64_2PART_C(0xa3ab6658, 0d5fdaf5), UINT64_2PART_C(0xc13e60d0, d2e0ebbb)},  // 10^-148
+  {UINT64_2PART_C(0xcc963fee, 10b7d1b3), UINT64_2PART_C(0x318df905, 079926a9)},  // 10^-147
+  {UINT64_2PART_C(0xffbbcfe9, 94e5c61f), UINT64_2PART_C(0xfdf17746, 497f7053)},  // 10^-146
+  {UINT64_2PART_C(0x9fd561f1, fd0f9bd3), UINT64_2PART_C(0xfeb6ea8b, edefa634)},  // 10^-145
+  {UINT64_2PART_C(0xc7caba6e, 7c5382c8), UINT64_2PART_C(0xfe64a52e, e96b8fc1)},  // 10^-144
+  {UINT64_2PART_C(0xf9bd690a, 1b68637b), UINT64_2PART_C(0x3dfdce7a, a3c673b1)},  // 10^-143
+  {UINT64_2PART_C(0x9c1661a6, 51213e2d), UINT64_2PART_C(0x06bea10c, a65c084f)},  // 10^-142
+  {UINT64_2PART_C(0xc31bfa0f, e5698db8), UINT64_2PART_C(0x486e494f, cff30a63)},  // 10^-141
+  {UINT64_2PART_C(0xf3e2f893, dec3f126), UINT64_2PART_C(0x5a89dba3, c3efccfb)},  // 10^-140
+  {UINT64_2PART_C(0x986ddb5c, 6b3a76b7), UINT64_2PART_C(0xf8962946, 5a75e01d)},  // 10^-139
+  {UINT64_2PART_C(0xbe895233, 86091465), UINT64_2PART_C(0xf6bbb397, f1135824)},  // 10^-138
+  {UINT64_2PART_C(0xee2ba6c0, 678b597f), UINT64_2PART_C(0x746aa07d, ed582e2d)},  // 10^-137
+  {UINT64_2PART_C(0x94db4838, 40b717ef), UINT64_2PART_C(0xa8c2a44e, b4571cdd)},  // 10^-136
+  {UINT64_2PART_C(0xba121a46, 50e4ddeb), UINT64_2PART_C(0x92f34d62, 616ce414)},  // 10^-135
+  {UINT64_2PART_C(0xe896a0d7, e51e1566), UINT64_2PART_C(0x77b020ba, f9c81d18)},  // 10^-134
+  {UINT64_2PART_C(0x915e2486, ef32cd60), UINT64_2PART_C(0x0ace1474, dc1d122f)},  // 10^-133
+  {UINT64_2PART_C(0xb5b5ada8, aaff80b8), UINT64_2PART_C(0x0d819992, 132456bb)},  // 10^-132
+  {UINT64_2PART_C(0xe3231912, d5bf60e6), UINT64_2PART_C(0x10e1fff6, 97ed6c6a)},  // 10^-131
+  {UINT64_2PART_C(0x8df5efab, c5979c8f), UINT64_2PART_C(0xca8d3ffa, 1ef463c2)},  // 10^-130
+  {UINT64_2PART_C(0xb1736b96, b6fd83b3), UINT64_2PART_C(0xbd308ff8, a6b17cb3)},  // 10^-129
+  {UINT64_2PART_C(0xddd0467c, 64bce4a0), UINT64_2PART_C(0xac7cb3f6, d05ddbdf)},  // 10^-128
+  {UINT64_2PART_C(0x8aa22c0d, bef60ee4), UINT64_2PART_C(0x6bcdf07a, 423aa96c)},  // 10^-127
+  {UINT64_2PART_C(0xad4ab711, 2eb3929d), UINT64_2PART_C(0x86c16c98, d2c953c7)},  // 10^-126
+  {UINT64_2PART_C(0xd89d64d5, 7a607744), UINT64_2PART_C(0xe871c7bf, 077ba8b8)},  // 10^-125
+  {UINT64_2PART_C(0x87625f05, 6c7c4a8b), UINT64_2PART_C(0x11471cd7, 64ad4973)},  // 10^-124
+  {UINT64_2PART_C(0xa93af6c6, c79b5d2d), UINT64_2PART_C(0xd598e40d, 3dd89bd0)},  // 10^-123
+  {UINT64_2PART_C(0xd389b478, 79823479), UINT64_2PART_C(0x4aff1d10, 8d4ec2c4)},  // 10^-122
+  {UINT64_2PART_C(0x843610cb, 4bf160cb), UINT64_2PART_C(0xcedf722a, 585139bb)},  // 10^-121
+  {UINT64_2PART_C(0xa54394fe, 1eedb8fe), UINT64_2PART_C(0xc2974eb4, ee658829)},  // 10^-120
+  {UINT64_2PART_C(0xce947a3d, a6a9273e), UINT64_2PART_C(0x733d2262, 29feea33)},  // 10^-119
+  {UINT64_2PART_C(0x811ccc66, 8829b887), UINT64_2PART_C(0x0806357d, 5a3f5260)},  // 10^-118
+  {UINT64_2PART_C(0xa163ff80, 2a3426a8), UINT64_2PART_C(0xca07c2dc, b0cf26f8)},  // 10^-117
+  {UINT64_2PART_C(0xc9bcff60, 34c13052), UINT64_2PART_C(0xfc89b393, dd02f0b6)},  // 10^-116
+  {UINT64_2PART_C(0xfc2c3f38, 41f17c67), UINT64_2PART_C(0xbbac2078, d443ace3)},  // 10^-115
+  {UINT64_2PART_C(0x9d9ba783, 2936edc0), UINT64_2PART_C(0xd54b944b, 84aa4c0e)},  // 10^-114
+  {UINT64_2PART_C(0xc5029163, f384a931), UINT64_2PART_C(0x0a9e795e, 65d4df12)},  // 10^-113
+  {UINT64_2PART_C(0xf64335bc, f065d37d), UINT64_2PART_C(0x4d4617b5, ff4a16d6)},  // 10^-112
+  {UINT64_2PART_C(0x99ea0196, 163fa42e), UINT64_2PART_C(0x504bced1, bf8e4e46)},  // 10^-111
+  {UINT64_2PART_C(0xc06481fb, 9bcf8d39), UINT64_2PART_C(0xe45ec286, 2f71e1d7)},  // 10^-110
+  {UINT64_2PART_C(0xf07da27a, 82c37088), UINT64_2PART_C(0x5d767327, bb4e5a4d)},  // 10^-109
+  {UINT64_2PART_C(0x964e858c, 91ba2655), UINT64_2PART_C(0x3a6a07f8, d510f870)},  // 10^-108
+  {UINT64_2PART_C(0xbbe226ef, b628afea), UINT64_2PART_C(0x890489f7, 0a55368c)},  // 10^-107
+  {UINT64_2PART_C(0xeadab0ab, a3b2dbe5), UINT64_2PART_C(0x2b45ac74, ccea842f)},  // 10^-106
+  {UINT64_2PART_C(0x92c8ae6b, 464fc96f), UINT64_2PART_C(0x3b0b8bc9, 0012929e)},  // 10^-105
+  {UINT64_2PART_C(0xb77ada06, 17e3bbcb), UINT64_2PART_C(0x09ce6ebb, 40173745)},  // 10^-104
+  {UINT64_2PART_C(0xe5599087, 9ddcaabd), UINT64_2PART_C(0xcc420a6a, 101d0516)},  // 10^-103
+  {UINT64_2PART_C(0x8f57fa54, c2a9eab6), UINT64_2PART_C(0x9fa94682, 4a12232e)},  // 10^-102
+  {UINT64_2PART_C(0xb32df8e9, f3546564), UINT64_2PART_C(0x47939822, dc96abfa)},  // 10^-101
+  {UINT64_2PART_C(0xdff97724, 70297ebd), UINT64_2PART_C(0x59787e2b, 93bc56f8)},  // 10^-100
+  {UINT64_2PART_C(0x8bfbea76, c619ef36), UINT64_2PART_C(0x57eb4edb, 3c55b65b)},  // 10^-99
+  {UINT64_2PART_C(0xaefae514, 77a06b03), UINT64_2PART_C(0xede62292, 0b6b23f2)},  // 10^-98
+  {UINT64_2PART_C(0xdab99e59, 958885c4), UINT64_2PART_C(0xe95fab36, 8e45ecee)},  // 10^-97
+  {UINT64_2PART_C(0x88b402f7, fd75539b), UINT64_2PART_C(0x11dbcb02, 18ebb415)},  // 10^-96
+  {UINT64_2PART_C(0xaae103b5, fcd2a881), UINT64_2PART_C(0xd652bdc2, 9f26a11a)},  // 10^-95
+  {UINT64_2PART_C(0xd59944a3, 7c0752a2), UINT64_2PART_C(0x4be76d33, 46f04960)},  // 10^-94
+  {UINT64_2PART_C(0x857fcae6, 2d8493a5), UINT64_2PART_C(0x6f70a440, 0c562ddc)},  // 10^-93
+  {UINT64_2PART_C(0xa6dfbd9f, b8e5b88e), UINT64_2PART_C(0xcb4ccd50, 0f6bb953)},  // 10^-92
+  {UINT64_2PART_C(0xd097ad07, a71f26b2), UINT64_2PART_C(0x7e2000a4, 1346a7a8)},  // 10^-91
+  {UINT64_2PART_C(0x825ecc24, c873782f), UINT64_2PART_C(0x8ed40066, 8c0c28c9)},  // 10^-90
+  {UINT64_2PART_C(0xa2f67f2d, fa90563b), UINT64_2PART_C(0x72890080, 2f0f32fb)},  // 10^-89
+  {UINT64_2PART_C(0xcbb41ef9, 79346bca), UINT64_2PART_C(0x4f2b40a0, 3ad2ffba)},  // 10^-88
+  {UINT64_2PART_C(0xfea126b7, d78186bc), UINT64_2PART_C(0xe2f610c8, 4987bfa9)},  // 10^-87
+  {UINT64_2PART_C(0x9f24b832, e6b0f436), UINT64_2PART_C(0x0dd9ca7d, 2df4d7ca)},  // 10^-86
+  {UINT64_2PART_C(0xc6ede63f, a05d3143), UINT64_2PART_C(0x91503d1c, 79720dbc)},  // 10^-85
+  {UINT64_2PART_C(0xf8a95fcf, 88747d94), UINT64_2PART_C(0x75a44c63, 97ce912b)},  // 10^-84
+  {UINT64_2PART_C(0x9b69dbe1, b548ce7c), UINT64_2PART_C(0xc986afbe, 3ee11abb)},  // 10^-83
+  {UINT64_2PART_C(0xc24452da, 229b021b), UINT64_2PART_C(0xfbe85bad, ce996169)},  // 10^-82
+  {UINT64_2PART_C(0xf2d56790, ab41c2a2), UINT64_2PART_C(0xfae27299, 423fb9c4)},  // 10^-81
+  {UINT64_2PART_C(0x97c560ba, 6b0919a5), UINT64_2PART_C(0xdccd879f, c967d41b)},  // 10^-80
+  {UINT64_2PART_C(0xbdb6b8e9, 05cb600f), UINT64_2PART_C(0x5400e987, bbc1c921)},  // 10^-79
+  {UINT64_2PART_C(0xed246723, 473e3813), UINT64_2PART_C(0x290123e9, aab23b69)},  // 10^-78
+  {UINT64_2PART_C(0x9436c076, 0c86e30b), UINT64_2PART_C(0xf9a0b672, 0aaf6522)},  // 10^-77
+  {UINT64_2PART_C(0xb9447093, 8fa89bce), UINT64_2PART_C(0xf808e40e, 8d5b3e6a)},  // 10^-76
+  {UINT64_2PART_C(0xe7958cb8, 7392c2c2), UINT64_2PART_C(0xb60b1d12, 30b20e05)},  // 10^-75
+  {UINT64_2PART_C(0x90bd77f3, 483bb9b9), UINT64_2PART_C(0xb1c6f22b, 5e6f48c3)},  // 10^-74
+  {UINT64_2PART_C(0xb4ecd5f0, 1a4aa828), UINT64_2PART_C(0x1e38aeb6, 360b1af4)},  // 10^-73
+  {UINT64_2PART_C(0xe2280b6c, 20dd5232), UINT64_2PART_C(0x25c6da63, c38de1b1)},  // 10^-72
+  {UINT64_2PART_C(0x8d590723, 948a535f), UINT64_2PART_C(0x579c487e, 5a38ad0f)},  // 10^-71
+  {UINT64_2PART_C(0xb0af48ec, 79ace837), UINT64_2PART_C(0x2d835a9d, f0c6d852)},  // 10^-70
+  {UINT64_2PART_C(0xdcdb1b27, 98182244), UINT64_2PART_C(0xf8e43145, 6cf88e66)},  // 10^-69
+  {UINT64_2PART_C(0x8a08f0f8, bf0f156b), UINT64_2PART_C(0x1b8e9ecb, 641b5900)},  // 10^-68
+  {UINT64_2PART_C(0xac8b2d36, eed2dac5), UINT64_2PART_C(0xe272467e, 3d222f40)},  // 10^-67
+  {UINT64_2PART_C(0xd7adf884, aa879177), UINT64_2PART_C(0x5b0ed81d, cc6abb10)},  // 10^-66
+  {UINT64_2PART_C(0x86ccbb52, ea94baea), UINT64_2PART_C(0x98e94712, 9fc2b4ea)},  // 10^-65
+  {UINT64_2PART_C(0xa87fea27, a539e9a5), UINT64_2PART_C(0x3f2398d7, 47b36225)},  // 10^-64
+  {UINT64_2PART_C(0xd29fe4b1, 8e88640e), UINT64_2PART_C(0x8eec7f0d, 19a03aae)},  // 10^-63
+  {UINT64_2PART_C(0x83a3eeee, f9153e89), UINT64_2PART_C(0x1953cf68, 300424ad)},  // 10^-62
+  {UINT64_2PART_C(0xa48ceaaa, b75a8e2b), UINT64_2PART_C(0x5fa8c342, 3c052dd8)},  // 10^-61
+  {UINT64_2PART_C(0xcdb02555, 653131b6), UINT64_2PART_C(0x3792f412, cb06794e)},  // 10^-60
+  {UINT64_2PART_C(0x808e1755, 5f3ebf11), UINT64_2PART_C(0xe2bbd88b, bee40bd1)},  // 10^-59
+  {UINT64_2PART_C(0xa0b19d2a, b70e6ed6), UINT64_2PART_C(0x5b6aceae, ae9d0ec5)},  // 10^-58
+  {UINT64_2PART_C(0xc8de0475, 64d20a8b), UINT64_2PART_C(0xf245825a, 5a445276)},  // 10^-57
+  {UINT64_2PART_C(0xfb158592, be068d2e), UINT64_2PART_C(0xeed6e2f0, f0d56713)},  // 10^-56
+  {UINT64_2PART_C(0x9ced737b, b6c4183d), UINT64_2PART_C(0x55464dd6, 9685606c)},  // 10^-55
+  {UINT64_2PART_C(0xc428d05a, a4751e4c), UINT64_2PART_C(0xaa97e14c, 3c26b887)},  // 10^-54
+  {UINT64_2PART_C(0xf5330471, 4d9265df), UINT64_2PART_C(0xd53dd99f, 4b3066a9)},  // 10^-53
+  {UINT64_2PART_C(0x993fe2c6, d07b7fab), UINT64_2PART_C(0xe546a803, 8efe402a)},  // 10^-52
+  {UINT64_2PART_C(0xbf8fdb78, 849a5f96), UINT64_2PART_C(0xde985204, 72bdd034)},  // 10^-51
+  {UINT64_2PART_C(0xef73d256, a5c0f77c), UINT64_2PART_C(0x963e6685, 8f6d4441)},  // 10^-50
+  {UINT64_2PART_C(0x95a86376, 27989aad), UINT64_2PART_C(0xdde70013, 79a44aa9)},  // 10^-49
+  {UINT64_2PART_C(0xbb127c53, b17ec159), UINT64_2PART_C(0x5560c018, 580d5d53)},  // 10^-48
+  {UINT64_2PART_C(0xe9d71b68, 9dde71af), UINT64_2PART_C(0xaab8f01e, 6e10b4a7)},  // 10^-47
+  {UINT64_2PART_C(0x92267121, 62ab070d), UINT64_2PART_C(0xcab39613, 04ca70e9)},  // 10^-46
+  {UINT64_2PART_C(0xb6b00d69, bb55c8d1), UINT64_2PART_C(0x3d607b97, c5fd0d23)},  // 10^-45
+  {UINT64_2PART_C(0xe45c10c4, 2a2b3b05), UINT64_2PART_C(0x8cb89a7d, b77c506b)},  // 10^-44
+  {UINT64_2PART_C(0x8eb98a7a, 9a5b04e3), UINT64_2PART_C(0x77f3608e, 92adb243)},  // 10^-43
+  {UINT64_2PART_C(0xb267ed19, 40f1c61c), UINT64_2PART_C(0x55f038b2, 37591ed4)},  // 10^-42
+  {UINT64_2PART_C(0xdf01e85f, 912e37a3), UINT64_2PART_C(0x6b6c46de, c52f6689)},  // 10^-41
+  {UINT64_2PART_C(0x8b61313b, babce2c6), UINT64_2PART_C(0x2323ac4b, 3b3da016)},  // 10^-40
+  {UINT64_2PART_C(0xae397d8a, a96c1b77), UINT64_2PART_C(0xabec975e, 0a0d081b)},  // 10^-39
+  {UINT64_2PART_C(0xd9c7dced, 53c72255), UINT64_2PART_C(0x96e7bd35, 8c904a22)},  // 10^-38
+  {UINT64_2PART_C(0x881cea14, 545c7575), UINT64_2PART_C(0x7e50d641, 77da2e55)},  // 10^-37
+  {UINT64_2PART_C(0xaa242499, 697392d2), UINT64_2PART_C(0xdde50bd1, d5d0b9ea)},  // 10^-36
+  {UINT64_2PART_C(0xd4ad2dbf, c3d07787), UINT64_2PART_C(0x955e4ec6, 4b44e865)},  // 10^-35
+  {UINT64_2PART_C(0x84ec3c97, da624ab4), UINT64_2PART_C(0xbd5af13b, ef0b113f)},  // 10^-34
+  {UINT64_2PART_C(0xa6274bbd, d0fadd61), UINT64_2PART_C(0xecb1ad8a, eacdd58f)},  // 10^-33
+  {UINT64_2PART_C(0xcfb11ead, 453994ba), UINT64_2PART_C(0x67de18ed, a5814af3)},  // 10^-32
+  {UINT64_2PART_C(0x81ceb32c, 4b43fcf4), UINT64_2PART_C(0x80eacf94, 8770ced8)},  // 10^-31
+  {UINT64_2PART_C(0xa2425ff7, 5e14fc31), UINT64_2PART_C(0xa1258379, a94d028e)},  // 10^-30
+  {UINT64_2PART_C(0xcad2f7f5, 359a3b3e), UINT64_2PART_C(0x096ee458, 13a04331)},  // 10^-29
+  {UINT64_2PART_C(0xfd87b5f2, 8300ca0d), UINT64_2PART_C(0x8bca9d6e, 188853fd)},  // 10^-28
+  {UINT64_2PART_C(0x9e74d1b7, 91e07e48), UINT64_2PART_C(0x775ea264, cf55347e)},  // 10^-27
+  {UINT64_2PART_C(0xc6120625, 76589dda), UINT64_2PART_C(0x95364afe, 032a819e)},  // 10^-26
+  {UINT64_2PART_C(0xf79687ae, d3eec551), UINT64_2PART_C(0x3a83ddbd, 83f52205)},  // 10^-25
+  {UINT64_2PART_C(0x9abe14cd, 44753b52), UINT64_2PART_C(0xc4926a96, 72793543)},  // 10^-24
+  {UINT64_2PART_C(0xc16d9a00, 95928a27), UINT64_2PART_C(0x75b7053c, 0f178294)},  // 10^-23
+  {UINT64_2PART_C(0xf1c90080, baf72cb1), UINT64_2PART_C(0x5324c68b, 12dd6339)},  // 10^-22
+  {UINT64_2PART_C(0x971da050, 74da7bee), UINT64_2PART_C(0xd3f6fc16, ebca5e04)},  // 10^-21
+  {UINT64_2PART_C(0xbce50864, 92111aea), UINT64_2PART_C(0x88f4bb1c, a6bcf585)},  // 10^-20
+  {UINT64_2PART_C(0xec1e4a7d, b69561a5), UINT64_2PART_C(0x2b31e9e3, d06c32e6)},  // 10^-19
+  {UINT64_2PART_C(0x9392ee8e, 921d5d07), UINT64_2PART_C(0x3aff322e, 62439fd0)},  // 10^-18
+  {UINT64_2PART_C(0xb877aa32, 36a4b449), UINT64_2PART_C(0x09befeb9, fad487c3)},  // 10^-17
+  {UINT64_2PART_C(0xe69594be, c44de15b), UINT64_2PART_C(0x4c2ebe68, 7989a9b4)},  // 10^-16
+  {UINT64_2PART_C(0x901d7cf7, 3ab0acd9), UINT64_2PART_C(0x0f9d3701, 4bf60a11)},  // 10^-15
+  {UINT64_2PART_C(0xb424dc35, 095cd80f), UINT64_2PART_C(0x538484c1, 9ef38c95)},  // 10^-14
+  {UINT64_2PART_C(0xe12e1342, 4bb40e13), UINT64_2PART_C(0x2865a5f2, 06b06fba)},  // 10^-13
+  {UINT64_2PART_C(0x8cbccc09, 6f5088cb), UINT64_2PART_C(0xf93f87b7, 442e45d4)},  // 10^-12
+  {UINT64_2PART_C(0xafebff0b, cb24aafe), UINT64_2PART_C(0xf78f69a5, 1539d749)},  // 10^-11
+  {UINT64_2PART_C(0xdbe6fece, bdedd5be), UINT64_2PART_C(0xb573440e, 5a884d1c)},  // 10^-10
+  {UINT64_2PART_C(0x89705f41, 36b4a597), UINT64_2PART_C(0x31680a88, f8953031)},  // 10^-9
+  {UINT64_2PART_C(0xabcc7711, 8461cefc), UINT64_2PART_C(0xfdc20d2b, 36ba7c3e)},  // 10^-8
+  {UINT64_2PART_C(0xd6bf94d5, e57a42bc), UINT64_2PART_C(0x3d329076, 04691b4d)},  // 10^-7
+  {UINT64_2PART_C(0x8637bd05, af6c69b5), UINT64_2PART_C(0xa63f9a49, c2c1b110)},  // 10^-6
+  {UINT64_2PART_C(0xa7c5ac47, 1b478423), UINT64_2PART_C(0x0fcf80dc, 33721d54)},  // 10^-5
+  {UINT64_2PART_C(0xd1b71758, e219652b), UINT64_2PART_C(0xd3c36113, 404ea4a9)},  // 10^-4
+  {UINT64_2PART_C(0x83126e97, 8d4fdf3b), UINT64_2PART_C(0x645a1cac, 083126ea)},  // 10^-3
+  {UINT64_2PART_C(0xa3d70a3d, 70a3d70a), UINT64_2PART_C(0x3d70a3d7, 0a3d70a4)},  // 10^-2
+  {UINT64_2PART_C(0xcccccccc, cccccccc), UINT64_2PART_C(0xcccccccc, cccccccd)},  // 10^-1
+  {UINT64_2PART_C(0x80000000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^0
+  {UINT64_2PART_C(0xa0000000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^1
+  {UINT64_2PART_C(0xc8000000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^2
+  {UINT64_2PART_C(0xfa000000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^3
+  {UINT64_2PART_C(0x9c400000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^4
+  {UINT64_2PART_C(0xc3500000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^5
+  {UINT64_2PART_C(0xf4240000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^6
+  {UINT64_2PART_C(0x98968000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^7
+  {UINT64_2PART_C(0xbebc2000, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^8
+  {UINT64_2PART_C(0xee6b2800, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^9
+  {UINT64_2PART_C(0x9502f900, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^10
+  {UINT64_2PART_C(0xba43b740, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^11
+  {UINT64_2PART_C(0xe8d4a510, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^12
+  {UINT64_2PART_C(0x9184e72a, 00000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^13
+  {UINT64_2PART_C(0xb5e620f4, 80000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^14
+  {UINT64_2PART_C(0xe35fa931, a0000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^15
+  {UINT64_2PART_C(0x8e1bc9bf, 04000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^16
+  {UINT64_2PART_C(0xb1a2bc2e, c5000000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^17
+  {UINT64_2PART_C(0xde0b6b3a, 76400000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^18
+  {UINT64_2PART_C(0x8ac72304, 89e80000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^19
+  {UINT64_2PART_C(0xad78ebc5, ac620000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^20
+  {UINT64_2PART_C(0xd8d726b7, 177a8000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^21
+  {UINT64_2PART_C(0x87867832, 6eac9000), UINT64_2PART_C(0x00000000, 00000000)},  // 10^22
+  {UINT64_2PART_C(0xa968163f, 0a57b400), UINT64_2PART_C(0x00000000, 00000000)},  // 10^23
+  {UINT64_2PART_C(0xd3c21bce, cceda100), UINT64_2PART_C(0x00000000, 00000000)},  // 10^24
+  {UINT64_2PART_C(0x84595161, 401484a0), UINT64_2PART_C(0x00000000, 00000000)},  // 10^25
+  {UINT64_2PART_C(0xa56fa5b9, 9019a5c8), UINT64_2PART_C(0x00000000, 00000000)},  // 10^26
+  {UINT64_2PART_C(0xcecb8f27, f4200f3a), UINT64_2PART_C(0x00000000, 00000000)},  // 10^27
+  {UINT64_2PART_C(0x813f3978, f8940984), UINT64_2PART_C(0x40000000, 00000000)},  // 10^28
+  {UINT64_2PART_C(0xa18f07d7, 36b90be5), UINT64_2PART_C(0x50000000, 00000000)},  // 10^29
+  {UINT64_2PART_C(0xc9f2c9cd, 04674ede), UINT64_2PART_C(0xa4000000, 00000000)},  // 10^30
+  {UINT64_2PART_C(0xfc6f7c40, 45812296), UINT64_2PART_C(0x4d000000, 00000000)},  // 10^31
+  {UINT64_2PART_C(0x9dc5ada8, 2b70b59d), UINT64_2PART_C(0xf0200000, 00000000)},  // 10^32
+  {UINT64_2PART_C(0xc5371912, 364ce305), UINT64_2PART_C(0x6c280000, 00000000)},  // 10^33
+  {UINT64_2PART_C(0xf684df56, c3e01bc6), UINT64_2PART_C(0xc7320000, 00000000)},  // 10^34
+  {UINT64_2PART_C(0x9a130b96, 3a6c115c), UINT64_2PART_C(0x3c7f4000, 00000000)},  // 10^35
+  {UINT64_2PART_C(0xc097ce7b, c90715b3), UINT64_2PART_C(0x4b9f1000, 00000000)},  // 10^36
+  {UINT64_2PART_C(0xf0bdc21a, bb48db20), UINT64_2PART_C(0x1e86d400, 00000000)},  // 10^37
+  {UINT64_2PART_C(0x96769950, b50d88f4), UINT64_2PART_C(0x13144480, 00000000)},  // 10^38
+  {UINT64_2PART_C(0xbc143fa4, e250eb31), UINT64_2PART_C(0x17d955a0, 00000000)},  // 10^39
+  {UINT64_2PART_C(0xeb194f8e, 1ae525fd), UINT64_2PART_C(0x5dcfab08, 00000000)},  // 10^40
+  {UINT64_2PART_C(0x92efd1b8, d0cf37be), UINT64_2PART_C(0x5aa1cae5, 00000000)},  // 10^41
+  {UINT64_2PART_C(0xb7abc627, 050305ad), UINT64_2PART_C(0xf14a3d9e, 40000000)},  // 10^42
+  {UINT64_2PART_C(0xe596b7b0, c643c719), UINT64_2PART_C(0x6d9ccd05, d0000000)},  // 10^43
+  {UINT64_2PART_C(0x8f7e32ce, 7bea5c6f), UINT64_2PART_C(0xe4820023, a2000000)},  // 10^44
+  {UINT64_2PART_C(0xb35dbf82, 1ae4f38b), UINT64_2PART_C(0xdda2802c, 8a800000)},  // 10^45
+  {UINT64_2PART_C(0xe0352f62, a19e306e), UINT64_2PART_C(0xd50b2037, ad200000)},  // 10^46
+  {UINT64_2PART_C(0x8c213d9d, a502de45), UINT64_2PART_C(0x4526f422, cc340000)},  // 10^47
+  {UINT64_2PART_C(0xaf298d05, 0e4395d6), UINT64_2PART_C(0x9670b12b, 7f410000)},  // 10^48
+  {UINT64_2PART_C(0xdaf3f046, 51d47b4c), UINT64_2PART_C(0x3c0cdd76, 5f114000)},  // 10^49
+  {UINT64_2PART_C(0x88d8762b, f324cd0f), UINT64_2PART_C(0xa5880a69, fb6ac800)},  // 10^50
+  {UINT64_2PART_C(0xab0e93b6, efee0053), UINT64_2PART_C(0x8eea0d04, 7a457a00)},  // 10^51
+  {UINT64_2PART_C(0xd5d238a4, abe98068), UINT64_2PART_C(0x72a49045, 98d6d880)},  // 10^52
+  {UINT64_2PART_C(0x85a36366, eb71f041), UINT64_2PART_C(0x47a6da2b, 7f864750)},  // 10^53
+  {UINT64_2PART_C(0xa70c3c40, a64e6c51), UINT64_2PART_C(0x999090b6, 5f67d924)},  // 10^54
+  {UINT64_2PART_C(0xd0cf4b50, cfe20765), UINT64_2PART_C(0xfff4b4e3, f741cf6d)},  // 10^55
+  {UINT64_2PART_C(0x82818f12, 81ed449f), UINT64_2PART_C(0xbff8f10e, 7a8921a5)},  // 10^56
+  {UINT64_2PART_C(0xa321f2d7, 226895c7), UINT64_2PART_C(0xaff72d52, 192b6a0e)},  // 10^57
+  {UINT64_2PART_C(0xcbea6f8c, eb02bb39), UINT64_2PART_C(0x9bf4f8a6, 9f764491)},  // 10^58
+  {UINT64_2PART_C(0xfee50b70, 25c36a08), UINT64_2PART_C(0x02f236d0, 4753d5b5)},  // 10^59
+  {UINT64_2PART_C(0x9f4f2726, 179a2245), UINT64_2PART_C(0x01d76242, 2c946591)},  // 10^60
+  {UINT64_2PART_C(0xc722f0ef, 9d80aad6), UINT64_2PART_C(0x424d3ad2, b7b97ef6)},  // 10^61
+  {UINT64_2PART_C(0xf8ebad2b, 84e0d58b), UINT64_2PART_C(0xd2e08987, 65a7deb3)},  // 10^62
+  {UINT64_2PART_C(0x9b934c3b, 330c8577), UINT64_2PART_C(0x63cc55f4, 9f88eb30)},  // 10^63
+  {UINT64_2PART_C(0xc2781f49, ffcfa6d5), UINT64_2PART_C(0x3cbf6b71, c76b25fc)},  // 10^64
+  {UINT64_2PART_C(0xf316271c, 7fc3908a), UINT64_2PART_C(0x8bef464e, 3945ef7b)},  // 10^65
+  {UINT64_2PART_C(0x97edd871, cfda3a56), UINT64_2PART_C(0x97758bf0, e3cbb5ad)},  // 10^66
+  {UINT64_2PART_C(0xbde94e8e, 43d0c8ec), UINT64_2PART_C(0x3d52eeed, 1cbea318)},  // 10^67
+  {UINT64_2PART_C(0xed63a231, d4c4fb27), UINT64_2PART_C(0x4ca7aaa8, 63ee4bde)},  // 10^68
+  {UINT64_2PART_C(0x945e455f, 24fb1cf8), UINT64_2PART_C(0x8fe8caa9, 3e74ef6b)},  // 10^69
+  {UINT64_2PART_C(0xb975d6b6, ee39e436), UINT64_2PART_C(0xb3e2fd53, 8e122b45)},  // 10^70
+  {UINT64_2PART_C(0xe7d34c64, a9c85d44), UINT64_2PART_C(0x60dbbca8, 7196b617)},  // 10^71
+  {UINT64_2PART_C(0x90e40fbe, ea1d3a4a), UINT64_2PART_C(0xbc8955e9, 46fe31ce)},  // 10^72
+  {UINT64_2PART_C(0xb51d13ae, a4a488dd), UINT64_2PART_C(0x6babab63, 98bdbe42)},  // 10^73
+  {UINT64_2PART_C(0xe264589a, 4dcdab14), UINT64_2PART_C(0xc696963c, 7eed2dd2)},  // 10^74
+  {UINT64_2PART_C(0x8d7eb760, 70a08aec), UINT64_2PART_C(0xfc1e1de5, cf543ca3)},  // 10^75
+  {UINT64_2PART_C(0xb0de6538, 8cc8ada8), UINT64_2PART_C(0x3b25a55f, 43294bcc)},  // 10^76
+  {UINT64_2PART_C(0xdd15fe86, affad912), UINT64_2PART_C(0x49ef0eb7, 13f39ebf)},  // 10^77
+  {UINT64_2PART_C(0x8a2dbf14, 2dfcc7ab), UINT64_2PART_C(0x6e356932, 6c784338)},  // 10^78
+  {UINT64_2PART_C(0xacb92ed9, 397bf996), UINT64_2PART_C(0x49c2c37f, 07965405)},  // 10^79
+  {UINT64_2PART_C(0xd7e77a8f, 87daf7fb), UINT64_2PART_C(0xdc33745e, c97be907)},  // 10^80
+  {UINT64_2PART_C(0x86f0ac99, b4e8dafd), UINT64_2PART_C(0x69a028bb, 3ded71a4)},  // 10^81
+  {UINT64_2PART_C(0xa8acd7c0, 222311bc), UINT64_2PART_C(0xc40832ea, 0d68ce0d)},  // 10^82
+  {UINT64_2PART_C(0xd2d80db0, 2aabd62b), UINT64_2PART_C(0xf50a3fa4, 90c30191)},  // 10^83
+  {UINT64_2PART_C(0x83c7088e, 1aab65db), UINT64_2PART_C(0x792667c6, da79e0fb)},  // 10^84
+  {UINT64_2PART_C(0xa4b8cab1, a1563f52), UINT64_2PART_C(0x577001b8, 91185939)},  // 10^85
+  {UINT64_2PART_C(0xcde6fd5e, 09abcf26), UINT64_2PART_C(0xed4c0226, b55e6f87)},  // 10^86
+  {UINT64_2PART_C(0x80b05e5a, c60b6178), UINT64_2PART_C(0x544f8158, 315b05b5)},  // 10^87
+  {UINT64_2PART_C(0xa0dc75f1, 778e39d6), UINT64_2PART_C(0x696361ae, 3db1c722)},  // 10^88
+  {UINT64_2PART_C(0xc913936d, d571c84c), UINT64_2PART_C(0x03bc3a19, cd1e38ea)},  // 10^89
+  {UINT64_2PART_C(0xfb587849, 4ace3a5f), UINT64_2PART_C(0x04ab48a0, 4065c724)},  // 10^90
+  {UINT64_2PART_C(0x9d174b2d, cec0e47b), UINT64_2PART_C(0x62eb0d64, 283f9c77)},  // 10^91
+  {UINT64_2PART_C(0xc45d1df9, 42711d9a), UINT64_2PART_C(0x3ba5d0bd, 324f8395)},  // 10^92
+  {UINT64_2PART_C(0xf5746577, 930d6500), UINT64_2PART_C(0xca8f44ec, 7ee3647a)},  // 10^93
+  {UINT64_2PART_C(0x9968bf6a, bbe85f20), UINT64_2PART_C(0x7e998b13, cf4e1ecc)},  // 10^94
+  {UINT64_2PART_C(0xbfc2ef45, 6ae276e8), UINT64_2PART_C(0x9e3fedd8, c321a67f)},  // 10^95
+  {UINT64_2PART_C(0xefb3ab16, c59b14a2), UINT64_2PART_C(0xc5cfe94e, f3ea101f)},  // 10^96
+  {UINT64_2PART_C(0x95d04aee, 3b80ece5), UINT64_2PART_C(0xbba1f1d1, 58724a13)},  // 10^97
+  {UINT64_2PART_C(0xbb445da9, ca61281f), UINT64_2PART_C(0x2a8a6e45, ae8edc98)},  // 10^98
+  {UINT64_2PART_C(0xea157514, 3cf97226), UINT64_2PART_C(0xf52d09d7, 1a3293be)},  // 10^99
+  {UINT64_2PART_C(0x924d692c, a61be758), UINT64_2PART_C(0x593c2626, 705f9c57)},  // 10^100
+  {UINT64_2PART_C(0xb6e0c377, cfa2e12e), UINT64_2PART_C(0x6f8b2fb0, 0c77836d)},  // 10^101
+  {UINT64_2PART_C(0xe498f455, c38b997a), UINT64_2PART_C(0x0b6dfb9c, 0f956448)},  // 10^102
+  {UINT64_2PART_C(0x8edf98b5, 9a373fec), UINT64_2PART_C(0x4724bd41, 89bd5ead)},  // 10^103
+  {UINT64_2PART_C(0xb2977ee3, 00c50fe7), UINT64_2PART_C(0x58edec91, ec2cb658)},  // 10^104
+  {UINT64_2PART_C(0xdf3d5e9b, c0f653e1), UINT64_2PART_C(0x2f2967b6, 6737e3ee)},  // 10^105
+  {UINT64_2PART_C(0x8b865b21, 5899f46c), UINT64_2PART_C(0xbd79e0d2, 0082ee75)},  // 10^106
+  {UINT64_2PART_C(0xae67f1e9, aec07187), UINT64_2PART_C(0xecd85906, 80a3aa12)},  // 10^107
+  {UINT64_2PART_C(0xda01ee64, 1a708de9), UINT64_2PART_C(0xe80e6f48, 20cc9496)},  // 10^108
+  {UINT64_2PART_C(0x884134fe, 908658b2), UINT64_2PART_C(0x3109058d, 147fdcde)},  // 10^109
+  {UINT64_2PART_C(0xaa51823e, 34a7eede), UINT64_2PART_C(0xbd4b46f0, 599fd416)},  // 10^110
+  {UINT64_2PART_C(0xd4e5e2cd, c1d1ea96), UINT64_2PART_C(0x6c9e18ac, 7007c91b)},  // 10^111
+  {UINT64_2PART_C(0x850fadc0, 9923329e), UINT64_2PART_C(0x03e2cf6b, c604ddb1)},  // 10^112
+  {UINT64_2PART_C(0xa6539930, bf6bff45), UINT64_2PART_C(0x84db8346, b786151d)},  // 10^113
+  {UINT64_2PART_C(0xcfe87f7c, ef46ff16), UINT64_2PART_C(0xe6126418, 65679a64)},  // 10^114
+  {UINT64_2PART_C(0x81f14fae, 158c5f6e), UINT64_2PART_C(0x4fcb7e8f, 3f60c07f)},  // 10^115
+  {UINT64_2PART_C(0xa26da399, 9aef7749), UINT64_2PART_C(0xe3be5e33, 0f38f09e)},  // 10^116
+  {UINT64_2PART_C(0xcb090c80, 01ab551c), UINT64_2PART_C(0x5cadf5bf, d3072cc6)},  // 10^117
+  {UINT64_2PART_C(0xfdcb4fa0, 02162a63), UINT64_2PART_C(0x73d9732f, c7c8f7f7)},  // 10^118
+  {UINT64_2PART_C(0x9e9f11c4, 014dda7e), UINT64_2PART_C(0x2867e7fd, dcdd9afb)},  // 10^119
+  {UINT64_2PART_C(0xc646d635, 01a1511d), UINT64_2PART_C(0xb281e1fd, 541501b9)},  // 10^120
+  {UINT64_2PART_C(0xf7d88bc2, 4209a565), UINT64_2PART_C(0x1f225a7c, a91a4227)},  // 10^121
+  {UINT64_2PART_C(0x9ae75759, 6946075f), UINT64_2PART_C(0x3375788d, e9b06959)},  // 10^122
+  {UINT64_2PART_C(0xc1a12d2f, c3978937), UINT64_2PART_C(0x0052d6b1, 641c83af)},  // 10^123
+  {UINT64_2PART_C(0xf209787b, b47d6b84), UINT64_2PART_C(0xc0678c5d, bd23a49b)},  // 10^124
+  {UINT64_2PART_C(0x9745eb4d, 50ce6332), UINT64_2PART_C(0xf840b7ba, 963646e1)},  // 10^125
+  {UINT64_2PART_C(0xbd176620, a501fbff), UINT64_2PART_C(0xb650e5a9, 3bc3d899)},  // 10^126
+  {UINT64_2PART_C(0xec5d3fa8, ce427aff), UINT64_2PART_C(0xa3e51f13, 8ab4cebf)},  // 10^127
+  {UINT64_2PART_C(0x93ba47c9, 80e98cdf), UINT64_2PART_C(0xc66f336c, 36b10138)},  // 10^128
+  {UINT64_2PART_C(0xb8a8d9bb, e123f017), UINT64_2PART_C(0xb80b0047, 445d4185)},  // 10^129
+  {UINT64_2PART_C(0xe6d3102a, d96cec1d), UINT64_2PART_C(0xa60dc059, 157491e6)},  // 10^130
+  {UINT64_2PART_C(0x9043ea1a, c7e41392), UINT64_2PART_C(0x87c89837, ad68db30)},  // 10^131
+  {UINT64_2PART_C(0xb454e4a1, 79dd1877), UINT64_2PART_C(0x29babe45, 98c311fc)},  // 10^132
+  {UINT64_2PART_C(0xe16a1dc9, d8545e94), UINT64_2PART_C(0xf4296dd6, fef3d67b)},  // 10^133
+  {UINT64_2PART_C(0x8ce2529e, 2734bb1d), UINT64_2PART_C(0x1899e4a6, 5f58660d)},  // 10^134
+  {UINT64_2PART_C(0xb01ae745, b101e9e4), UINT64_2PART_C(0x5ec05dcf, f72e7f90)},  // 10^135
+  {UINT64_2PART_C(0xdc21a117, 1d42645d), UINT64_2PART_C(0x76707543, f4fa1f74)},  // 10^136
+  {UINT64_2PART_C(0x899504ae, 72497eba), UINT64_2PART_C(0x6a06494a, 791c53a9)},  // 10^137
+  {UINT64_2PART_C(0xabfa45da, 0edbde69), UINT64_2PART_C(0x0487db9d, 17636893)},  // 10^138
+  {UINT64_2PART_C(0xd6f8d750, 9292d603), UINT64_2PART_C(0x45a9d284, 5d3c42b7)},  // 10^139
+  {UINT64_2PART_C(0x865b8692, 5b9bc5c2), UINT64_2PART_C(0x0b8a2392, ba45a9b3)},  // 10^140
+  {UINT64_2PART_C(0xa7f26836, f282b732), UINT64_2PART_C(0x8e6cac77, 68d7141f)},  // 10^141
+  {UINT64_2PART_C(0xd1ef0244, af2364ff), UINT64_2PART_C(0x3207d795, 430cd927)},  // 10^142
+  {UINT64_2PART_C(0x8335616a, ed761f1f), UINT64_2PART_C(0x7f44e6bd, 49e807b9)},  // 10^143
+  {UINT64_2PART_C(0xa402b9c5, a8d3a6e7), UINT64_2PART_C(0x5f16206c, 9c6209a7)},  // 10^144
+  {UINT64_2PART_C(0xcd036837, 130890a1), UINT64_2PART_C(0x36dba887, c37a8c10)},  // 10^145
+  {UINT64_2PART_C(0x80222122, 6be55a64), UINT64_2PART_C(0xc2494954, da2c978a)},  // 10^146
+  {UINT64_2PART_C(0xa02aa96b, 06deb0fd), UINT64_2PART_C(0xf2db9baa, 10b7bd6d)},  // 10^147
+  {UINT64_2PART_C(0xc83553c5, c8965d3d), UINT64_2PART_C(0x6f928294, 94e5acc8)},  // 10^148
+  {UINT64_2PART_C(0xfa42a8b7, 3abbf48c), UINT64_2PART_C(0xcb772339, ba1f17fa)},  // 10^149
+  {UINT64_2PART_C(0x9c69a972, 84b578d7), UINT64_2PART_C(0xff2a7604, 14536efc)},  // 10^150
+  {UINT64_2PART_C(0xc38413cf, 25e2d70d), UINT64_2PART_C(0xfef51385, 19684abb)},  // 10^151
+  {UINT64_2PART_C(0xf46518c2, ef5b8cd1), UINT64_2PART_C(0x7eb25866, 5fc25d6a)},  // 10^152
+  {UINT64_2PART_C(0x98bf2f79, d5993802), UINT64_2PART_C(0xef2f773f, fbd97a62)},  // 10^153
+  {UINT64_2PART_C(0xbeeefb58, 4aff8603), UINT64_2PART_C(0xaafb550f, facfd8fb)},  // 10^154
+  {UINT64_2PART_C(0xeeaaba2e, 5dbf6784), UINT64_2PART_C(0x95ba2a53, f983cf39)},  // 10^155
+  {UINT64_2PART_C(0x952ab45c, fa97a0b2), UINT64_2PART_C(0xdd945a74, 7bf26184)},  // 10^156
+  {UINT64_2PART_C(0xba756174, 393d88df), UINT64_2PART_C(0x94f97111, 9aeef9e5)},  // 10^157
+  {UINT64_2PART_C(0xe912b9d1, 478ceb17), UINT64_2PART_C(0x7a37cd56, 01aab85e)},  // 10^158
+  {UINT64_2PART_C(0x91abb422, ccb812ee), UINT64_2PART_C(0xac62e055, c10ab33b)},  // 10^159
+  {UINT64_2PART_C(0xb616a12b, 7fe617aa), UINT64_2PART_C(0x577b986b, 314d600a)},  // 10^160
+  {UINT64_2PART_C(0xe39c4976, 5fdf9d94), UINT64_2PART_C(0xed5a7e85, fda0b80c)},  // 10^161
+  {UINT64_2PART_C(0x8e41ade9, fbebc27d), UINT64_2PART_C(0x14588f13, be847308)},  // 10^162
+  {UINT64_2PART_C(0xb1d21964, 7ae6b31c), UINT64_2PART_C(0x596eb2d8, ae258fc9)},  // 10^163
+  {UINT64_2PART_C(0xde469fbd, 99a05fe3), UINT64_2PART_C(0x6fca5f8e, d9aef3bc)},  // 10^164
+  {UINT64_2PART_C(0x8aec23d6, 80043bee), UINT64_2PART_C(0x25de7bb9, 480d5855)},  // 10^165
+  {UINT64_2PART_C(0xada72ccc, 20054ae9), UINT64_2PART_C(0xaf561aa7, 9a10ae6b)},  // 10^166
+  {UINT64_2PART_C(0xd910f7ff, 28069da4), UINT64_2PART_C(0x1b2ba151, 8094da05)},  // 10^167
+  {UINT64_2PART_C(0x87aa9aff, 79042286), UINT64_2PART_C(0x90fb44d2, f05d0843)},  // 10^168
+  {UINT64_2PART_C(0xa99541bf, 57452b28), UINT64_2PART_C(0x353a1607, ac744a54)},  // 10^169
+  {UINT64_2PART_C(0xd3fa922f, 2d1675f2), UINT64_2PART_C(0x42889b89, 97915ce9)},  // 10^170
+  {UINT64_2PART_C(0x847c9b5d, 7c2e09b7), UINT64_2PART_C(0x69956135, febada12)},  // 10^171
+  {UINT64_2PART_C(0xa59bc234, db398c25), UINT64_2PART_C(0x43fab983, 7e699096)},  // 10^172
+  {UINT64_2PART_C(0xcf02b2c2, 1207ef2e), UINT64_2PART_C(0x94f967e4, 5e03f4bc)},  // 10^173
+  {UINT64_2PART_C(0x8161afb9, 4b44f57d), UINT64_2PART_C(0x1d1be0ee, bac278f6)},  // 10^174
+  {UINT64_2PART_C(0xa1ba1ba7, 9e1632dc), UINT64_2PART_C(0x6462d92a, 69731733)},  // 10^175
+  {UINT64_2PART_C(0xca28a291, 859bbf93), UINT64_2PART_C(0x7d7b8f75, 03cfdcff)},  // 10^176
+  {UINT64_2PART_C(0xfcb2cb35, e702af78), UINT64_2PART_C(0x5cda7352, 44c3d43f)},  // 10^177
+  {UINT64_2PART_C(0x9defbf01, b061adab), UINT64_2PART_C(0x3a088813, 6afa64a8)},  // 10^178
+  {UINT64_2PART_C(0xc56baec2, 1c7a1916), UINT64_2PART_C(0x088aaa18, 45b8fdd1)},  // 10^179
+  {UINT64_2PART_C(0xf6c69a72, a3989f5b), UINT64_2PART_C(0x8aad549e, 57273d46)},  // 10^180
+  {UINT64_2PART_C(0x9a3c2087, a63f6399), UINT64_2PART_C(0x36ac54e2, f678864c)},  // 10^181
+  {UINT64_2PART_C(0xc0cb28a9, 8fcf3c7f), UINT64_2PART_C(0x84576a1b, b416a7de)},  // 10^182
+  {UINT64_2PART_C(0xf0fdf2d3, f3c30b9f), UINT64_2PART_C(0x656d44a2, a11c51d6)},  // 10^183
+  {UINT64_2PART_C(0x969eb7c4, 7859e743), UINT64_2PART_C(0x9f644ae5, a4b1b326)},  // 10^184
+  {UINT64_2PART_C(0xbc4665b5, 96706114), UINT64_2PART_C(0x873d5d9f, 0dde1fef)},  // 10^185
+  {UINT64_2PART_C(0xeb57ff22, fc0c7959), UINT64_2PART_C(0xa90cb506, d155a7eb)},  // 10^186
+  {UINT64_2PART_C(0x9316ff75, dd87cbd8), UINT64_2PART_C(0x09a7f124, 42d588f3)},  // 10^187
+  {UINT64_2PART_C(0xb7dcbf53, 54e9bece), UINT64_2PART_C(0x0c11ed6d, 538aeb30)},  // 10^188
+  {UINT64_2PART_C(0xe5d3ef28, 2a242e81), UINT64_2PART_C(0x8f1668c8, a86da5fb)},  // 10^189
+  {UINT64_2PART_C(0x8fa47579, 1a569d10), UINT64_2PART_C(0xf96e017d, 694487bd)},  // 10^190
+  {UINT64_2PART_C(0xb38d92d7, 60ec4455), UINT64_2PART_C(0x37c981dc, c395a9ad)},  // 10^191
+  {UINT64_2PART_C(0xe070f78d, 3927556a), UINT64_2PART_C(0x85bbe253, f47b1418)},  // 10^192
+  {UINT64_2PART_C(0x8c469ab8, 43b89562), UINT64_2PART_C(0x93956d74, 78ccec8f)},  // 10^193
+  {UINT64_2PART_C(0xaf584166, 54a6babb), UINT64_2PART_C(0x387ac8d1, 970027b3)},  // 10^194
+  {UINT64_2PART_C(0xdb2e51bf, e9d0696a), UINT64_2PART_C(0x06997b05, fcc0319f)},  // 10^195
+  {UINT64_2PART_C(0x88fcf317, f22241e2), UINT64_2PART_C(0x441fece3, bdf81f04)},  // 10^196
+  {UINT64_2PART_C(0xab3c2fdd, eeaad25a), UINT64_2PART_C(0xd527e81c, ad7626c4)},  // 10^197
+  {UINT64_2PART_C(0xd60b3bd5, 6a5586f1), UINT64_2PART_C(0x8a71e223, d8d3b075)},  // 10^198
+  {UINT64_2PART_C(0x85c70565, 62757456), UINT64_2PART_C(0xf6872d56, 67844e4a)},  // 10^199
+  {UINT64_2PART_C(0xa738c6be, bb12d16c), UINT64_2PART_C(0xb428f8ac, 016561dc)},  // 10^200
+  {UINT64_2PART_C(0xd106f86e, 69d785c7), UINT64_2PART_C(0xe13336d7, 01beba53)},  // 10^201
+  {UINT64_2PART_C(0x82a45b45, 0226b39c), UINT64_2PART_C(0xecc00246, 61173474)},  // 10^202
+  {UINT64_2PART_C(0xa34d7216, 42b06084), UINT64_2PART_C(0x27f002d7, f95d0191)},  // 10^203
+  {UINT64_2PART_C(0xcc20ce9b, d35c78a5), UINT64_2PART_C(0x31ec038d, f7b441f5)},  // 10^204
+  {UINT64_2PART_C(0xff290242, c83396ce), UINT64_2PART_C(0x7e670471, 75a15272)},  // 10^205
+  {UINT64_2PART_C(0x9f79a169, bd203e41), UINT64_2PART_C(0x0f0062c6, e984d387)},  // 10^206
+  {UINT64_2PART_C(0xc75809c4, 2c684dd1), UINT64_2PART_C(0x52c07b78, a3e60869)},  // 10^207
+  {UINT64_2PART_C(0xf92e0c35, 37826145), UINT64_2PART_C(0xa7709a56, ccdf8a83)},  // 10^208
+  {UINT64_2PART_C(0x9bbcc7a1, 42b17ccb), UINT64_2PART_C(0x88a66076, 400bb692)},  // 10^209
+  {UINT64_2PART_C(0xc2abf989, 935ddbfe), UINT64_2PART_C(0x6acff893, d00ea436)},  // 10^210
+  {UINT64_2PART_C(0xf356f7eb, f83552fe), UINT64_2PART_C(0x0583f6b8, c4124d44)},  // 10^211
+  {UINT64_2PART_C(0x98165af3, 7b2153de), UINT64_2PART_C(0xc3727a33, 7a8b704b)},  // 10^212
+  {UINT64_2PART_C(0xbe1bf1b0, 59e9a8d6), UINT64_2PART_C(0x744f18c0, 592e4c5d)},  // 10^213
+  {UINT64_2PART_C(0xeda2ee1c, 7064130c), UINT64_2PART_C(0x1162def0, 6f79df74)},  // 10^214
+  {UINT64_2PART_C(0x9485d4d1, c63e8be7), UINT64_2PART_C(0x8addcb56, 45ac2ba9)},  // 10^215
+  {UINT64_2PART_C(0xb9a74a06, 37ce2ee1), UINT64_2PART_C(0x6d953e2b, d7173693)},  // 10^216
+  {UINT64_2PART_C(0xe8111c87, c5c1ba99), UINT64_2PART_C(0xc8fa8db6, ccdd0438)},  // 10^217
+  {UINT64_2PART_C(0x910ab1d4, db9914a0), UINT64_2PART_C(0x1d9c9892, 400a22a3)},  // 10^218
+  {UINT64_2PART_C(0xb54d5e4a, 127f59c8), UINT64_2PART_C(0x2503beb6, d00cab4c)},  // 10^219
+  {UINT64_2PART_C(0xe2a0b5dc, 971f303a), UINT64_2PART_C(0x2e44ae64, 840fd61e)},  // 10^220
+  {UINT64_2PART_C(0x8da471a9, de737e24), UINT64_2PART_C(0x5ceaecfe, d289e5d3)},  // 10^221
+  {UINT64_2PART_C(0xb10d8e14, 56105dad), UINT64_2PART_C(0x7425a83e, 872c5f48)},  // 10^222
+  {UINT64_2PART_C(0xdd50f199, 6b947518), UINT64_2PART_C(0xd12f124e, 28f7771a)},  // 10^223
+  {UINT64_2PART_C(0x8a5296ff, e33cc92f), UINT64_2PART_C(0x82bd6b70, d99aaa70)},  // 10^224
+  {UINT64_2PART_C(0xace73cbf, dc0bfb7b), UINT64_2PART_C(0x636cc64d, 1001550c)},  // 10^225
+  {UINT64_2PART_C(0xd8210bef, d30efa5a), UINT64_2PART_C(0x3c47f7e0, 5401aa4f)},  // 10^226
+  {UINT64_2PART_C(0x8714a775, e3e95c78), UINT64_2PART_C(0x65acfaec, 34810a72)},  // 10^227
+  {UINT64_2PART_C(0xa8d9d153, 5ce3b396), UINT64_2PART_C(0x7f1839a7, 41a14d0e)},  // 10^228
+  {UINT64_2PART_C(0xd31045a8, 341ca07c), UINT64_2PART_C(0x1ede4811, 1209a051)},  // 10^229
+  {UINT64_2PART_C(0x83ea2b89, 2091e44d), UINT64_2PART_C(0x934aed0a, ab460433)},  // 10^230
+  {UINT64_2PART_C(0xa4e4b66b, 68b65d60), UINT64_2PART_C(0xf81da84d, 56178540)},  // 10^231
+  {UINT64_2PART_C(0xce1de406, 42e3f4b9), UINT64_2PART_C(0x36251260, ab9d668f)},  // 10^232
+  {UINT64_2PART_C(0x80d2ae83, e9ce78f3), UINT64_2PART_C(0xc1d72b7c, 6b42601a)},  // 10^233
+  {UINT64_2PART_C(0xa1075a24, e4421730), UINT64_2PART_C(0xb24cf65b, 8612f820)},  // 10^234
+  {UINT64_2PART_C(0xc94930ae, 1d529cfc), UINT64_2PART_C(0xdee033f2, 6797b628)},  // 10^235
+  {UINT64_2PART_C(0xfb9b7cd9, a4a7443c), UINT64_2PART_C(0x169840ef, 017da3b2)},  // 10^236
+  {UINT64_2PART_C(0x9d412e08, 06e88aa5), UINT64_2PART_C(0x8e1f2895, 60ee864f)},  // 10^237
+  {UINT64_2PART_C(0xc491798a, 08a2ad4e), UINT64_2PART_C(0xf1a6f2ba, b92a27e3)},  // 10^238
+  {UINT64_2PART_C(0xf5b5d7ec, 8acb58a2), UINT64_2PART_C(0xae10af69, 6774b1dc)},  // 10^239
+  {UINT64_2PART_C(0x9991a6f3, d6bf1765), UINT64_2PART_C(0xacca6da1, e0a8ef2a)},  // 10^240
+  {UINT64_2PART_C(0xbff610b0, cc6edd3f), UINT64_2PART_C(0x17fd090a, 58d32af4)},  // 10^241
+  {UINT64_2PART_C(0xeff394dc, ff8a948e), UINT64_2PART_C(0xddfc4b4c, ef07f5b1)},  // 10^242
+  {UINT64_2PART_C(0x95f83d0a, 1fb69cd9), UINT64_2PART_C(0x4abdaf10, 1564f98f)},  // 10^243
+  {UINT64_2PART_C(0xbb764c4c, a7a4440f), UINT64_2PART_C(0x9d6d1ad4, 1abe37f2)},  // 10^244
+  {UINT64_2PART_C(0xea53df5f, d18d5513), UINT64_2PART_C(0x84c86189, 216dc5ee)},  // 10^245
+  {UINT64_2PART_C(0x92746b9b, e2f8552c), UINT64_2PART_C(0x32fd3cf5, b4e49bb5)},  // 10^246
+  {UINT64_2PART_C(0xb7118682, dbb66a77), UINT64_2PART_C(0x3fbc8c33, 221dc2a2)},  // 10^247
+  {UINT64_2PART_C(0xe4d5e823, 92a40515), UINT64_2PART_C(0x0fabaf3f, eaa5334b)},  // 10^248
+  {UINT64_2PART_C(0x8f05b116, 3ba6832d), UINT64_2PART_C(0x29cb4d87, f2a7400f)},  // 10^249
+  {UINT64_2PART_C(0xb2c71d5b, ca9023f8), UINT64_2PART_C(0x743e20e9, ef511013)},  // 10^250
+  {UINT64_2PART_C(0xdf78e4b2, bd342cf6), UINT64_2PART_C(0x914da924, 6b255417)},  // 10^251
+  {UINT64_2PART_C(0x8bab8eef, b6409c1a), UINT64_2PART_C(0x1ad089b6, c2f7548f)},  // 10^252
+  {UINT64_2PART_C(0xae9672ab, a3d0c320), UINT64_2PART_C(0xa184ac24, 73b529b2)},  // 10^253
+  {UINT64_2PART_C(0xda3c0f56, 8cc4f3e8), UINT64_2PART_C(0xc9e5d72d, 90a2741f)},  // 10^254
+  {UINT64_2PART_C(0x88658996, 17fb1871), UINT64_2PART_C(0x7e2fa67c, 7a658893)},  // 10^255
+  {UINT64_2PART_C(0xaa7eebfb, 9df9de8d), UINT64_2PART_C(0xddbb901b, 98feeab8)},  // 10^256
+  {UINT64_2PART_C(0xd51ea6fa, 85785631), UINT64_2PART_C(0x552a7422, 7f3ea566)},  // 10^257
+  {UINT64_2PART_C(0x8533285c, 936b35de), UINT64_2PART_C(0xd53a8895, 8f872760)},  // 10^258
+  {UINT64_2PART_C(0xa67ff273, b8460356), UINT64_2PART_C(0x8a892aba, f368f138)},  // 10^259
+  {UINT64_2PART_C(0xd01fef10, a657842c), UINT64_2PART_C(0x2d2b7569, b0432d86)},  // 10^260
+  {UINT64_2PART_C(0x8213f56a, 67f6b29b), UINT64_2PART_C(0x9c3b2962, 0e29fc74)},  // 10^261
+  {UINT64_2PART_C(0xa298f2c5, 01f45f42), UINT64_2PART_C(0x8349f3ba, 91b47b90)},  // 10^262
+  {UINT64_2PART_C(0xcb3f2f76, 42717713), UINT64_2PART_C(0x241c70a9, 36219a74)},  // 10^263
+  {UINT64_2PART_C(0xfe0efb53, d30dd4d7), UINT64_2PART_C(0xed238cd3, 83aa0111)},  // 10^264
+  {UINT64_2PART_C(0x9ec95d14, 63e8a506), UINT64_2PART_C(0xf4363804, 324a40ab)},  // 10^265
+  {UINT64_2PART_C(0xc67bb459, 7ce2ce48), UINT64_2PART_C(0xb143c605, 3edcd0d6)},  // 10^266
+  {UINT64_2PART_C(0xf81aa16f, dc1b81da), UINT64_2PART_C(0xdd94b786, 8e94050b)},  // 10^267
+  {UINT64_2PART_C(0x9b10a4e5, e9913128), UINT64_2PART_C(0xca7cf2b4, 191c8327)},  // 10^268
+  {UINT64_2PART_C(0xc1d4ce1f, 63f57d72), UINT64_2PART_C(0xfd1c2f61, 1f63a3f1)},  // 10^269
+  {UINT64_2PART_C(0xf24a01a7, 3cf2dccf), UINT64_2PART_C(0xbc633b39, 673c8ced)},  // 10^270
+  {UINT64_2PART_C(0x976e4108, 8617ca01), UINT64_2PART_C(0xd5be0503, e085d814)},  // 10^271
+  {UINT64_2PART_C(0xbd49d14a, a79dbc82), UINT64_2PART_C(0x4b2d8644, d8a74e19)},  // 10^272
+  {UINT64_2PART_C(0xec9c459d, 51852ba2), UINT64_2PART_C(0xddf8e7d6, 0ed1219f)},  // 10^273
+  {UINT64_2PART_C(0x93e1ab82, 52f33b45), UINT64_2PART_C(0xcabb90e5, c942b504)},  // 10^274
+  {UINT64_2PART_C(0xb8da1662, e7b00a17), UINT64_2PART_C(0x3d6a751f, 3b936244)},  // 10^275
+  {UINT64_2PART_C(0xe7109bfb, a19c0c9d), UINT64_2PART_C(0x0cc51267, 0a783ad5)},  // 10^276
+  {UINT64_2PART_C(0x906a617d, 450187e2), UINT64_2PART_C(0x27fb2b80, 668b24c6)},  // 10^277
+  {UINT64_2PART_C(0xb484f9dc, 9641e9da), UINT64_2PART_C(0xb1f9f660, 802dedf7)},  // 10^278
+  {UINT64_2PART_C(0xe1a63853, bbd26451), UINT64_2PART_C(0x5e7873f8, a0396974)},  // 10^279
+  {UINT64_2PART_C(0x8d07e334, 55637eb2), UINT64_2PART_C(0xdb0b487b, 6423e1e9)},  // 10^280
+  {UINT64_2PART_C(0xb049dc01, 6abc5e5f), UINT64_2PART_C(0x91ce1a9a, 3d2cda63)},  // 10^281
+  {UINT64_2PART_C(0xdc5c5301, c56b75f7), UINT64_2PART_C(0x7641a140, cc7810fc)},  // 10^282
+  {UINT64_2PART_C(0x89b9b3e1, 1b6329ba), UINT64_2PART_C(0xa9e904c8, 7fcb0a9e)},  // 10^283
+  {UINT64_2PART_C(0xac2820d9, 623bf429), UINT64_2PART_C(0x546345fa, 9fbdcd45)},  // 10^284
+  {UINT64_2PART_C(0xd732290f, bacaf133), UINT64_2PART_C(0xa97c1779, 47ad4096)},  // 10^285
+  {UINT64_2PART_C(0x867f59a9, d4bed6c0), UINT64_2PART_C(0x49ed8eab, cccc485e)},  // 10^286
+  {UINT64_2PART_C(0xa81f3014, 49ee8c70), UINT64_2PART_C(0x5c68f256, bfff5a75)},  // 10^287
+  {UINT64_2PART_C(0xd226fc19, 5c6a2f8c), UINT64_2PART_C(0x73832eec, 6fff3112)},  // 10^288
+  {UINT64_2PART_C(0x83585d8f, d9c25db7), UINT64_2PART_C(0xc831fd53, c5ff7eac)},  // 10^289
+  {UINT64_2PART_C(0xa42e74f3, d032f525), UINT64_2PART_C(0xba3e7ca8, b77f5e56)},  // 10^290
+  {UINT64_2PART_C(0xcd3a1230, c43fb26f), UINT64_2PART_C(0x28ce1bd2, e55f35ec)},  // 10^291
+  {UINT64_2PART_C(0x80444b5e, 7aa7cf85), UINT64_2PART_C(0x7980d163, cf5b81b4)},  // 10^292
+  {UINT64_2PART_C(0xa0555e36, 1951c366), UINT64_2PART_C(0xd7e105bc, c3326220)},  // 10^293
+  {UINT64_2PART_C(0xc86ab5c3, 9fa63440), UINT64_2PART_C(0x8dd9472b, f3fefaa8)},  // 10^294
+  {UINT64_2PART_C(0xfa856334, 878fc150), UINT64_2PART_C(0xb14f98f6, f0feb952)},  // 10^295
+  {UINT64_2PART_C(0x9c935e00, d4b9d8d2), UINT64_2PART_C(0x6ed1bf9a, 569f33d4)},  // 10^296
+  {UINT64_2PART_C(0xc3b83581, 09e84f07), UINT64_2PART_C(0x0a862f80, ec4700c9)},  // 10^297
+  {UINT64_2PART_C(0xf4a642e1, 4c6262c8), UINT64_2PART_C(0xcd27bb61, 2758c0fb)},  // 10^298
+  {UINT64_2PART_C(0x98e7e9cc, cfbd7dbd), UINT64_2PART_C(0x8038d51c, b897789d)},  // 10^299
+  {UINT64_2PART_C(0xbf21e440, 03acdd2c), UINT64_2PART_C(0xe0470a63, e6bd56c4)},  // 10^300
+  {UINT64_2PART_C(0xeeea5d50, 04981478), UINT64_2PART_C(0x1858ccfc, e06cac75)},  // 10^301
+  {UINT64_2PART_C(0x95527a52, 02df0ccb), UINT64_2PART_C(0x0f37801e, 0c43ebc9)},  // 10^302
+  {UINT64_2PART_C(0xbaa718e6, 8396cffd), UINT64_2PART_C(0xd3056025, 8f54e6bb)},  // 10^303
+  {UINT64_2PART_C(0xe950df20, 247c83fd), UINT64_2PART_C(0x47c6b82e, f32a206a)},  // 10^304
+  {UINT64_2PART_C(0x91d28b74, 16cdd27e), UINT64_2PART_C(0x4cdc331d, 57fa5442)},  // 10^305
+  {UINT64_2PART_C(0xb6472e51, 1c81471d), UINT64_2PART_C(0xe0133fe4, adf8e953)},  // 10^306
+  {UINT64_2PART_C(0xe3d8f9e5, 63a198e5), UINT64_2PART_C(0x58180fdd, d97723a7)},  // 10^307
+  {UINT64_2PART_C(0x8e679c2f, 5e44ff8f), UINT64_2PART_C(0x570f09ea, a7ea7649)},  // 10^308
+  {UINT64_2PART_C(0xb201833b, 35d63f73), UINT64_2PART_C(0x2cd2cc65, 51e513db)},  // 10^309
+  {UINT64_2PART_C(0xde81e40a, 034bcf4f), UINT64_2PART_C(0xf8077f7e, a65e58d2)},  // 10^310
+  {UINT64_2PART_C(0x8b112e86, 420f6191), UINT64_2PART_C(0xfb04afaf, 27faf783)},  // 10^311
+  {UINT64_2PART_C(0xadd57a27, d29339f6), UINT64_2PART_C(0x79c5db9a, f1f9b564)},  // 10^312
+  {UINT64_2PART_C(0xd94ad8b1, c7380874), UINT64_2PART_C(0x18375281, ae7822bd)},  // 10^313
+  {UINT64_2PART_C(0x87cec76f, 1c830548), UINT64_2PART_C(0x8f229391, 0d0b15b6)},  // 10^314
+  {UINT64_2PART_C(0xa9c2794a, e3a3c69a), UINT64_2PART_C(0xb2eb3875, 504ddb23)},  // 10^315
+  {UINT64_2PART_C(0xd433179d, 9c8cb841), UINT64_2PART_C(0x5fa60692, a46151ec)},  // 10^316
+  {UINT64_2PART_C(0x849feec2, 81d7f328), UINT64_2PART_C(0xdbc7c41b, a6bcd334)},  // 10^317
+  {UINT64_2PART_C(0xa5c7ea73, 224deff3), UINT64_2PART_C(0x12b9b522, 906c0801)},  // 10^318
+  {UINT64_2PART_C(0xcf39e50f, eae16bef), UINT64_2PART_C(0xd768226b, 34870a01)},  // 10^319
+  {UINT64_2PART_C(0x81842f29, f2cce375), UINT64_2PART_C(0xe6a11583, 00d46641)},  // 10^320
+  {UINT64_2PART_C(0xa1e53af4, 6f801c53), UINT64_2PART_C(0x60495ae3, c1097fd1)},  // 10^321
+  {UINT64_2PART_C(0xca5e89b1, 8b602368), UINT64_2PART_C(0x385bb19c, b14bdfc5)},  // 10^322
+  {UINT64_2PART_C(0xfcf62c1d, ee382c42), UINT64_2PART_C(0x46729e03, dd9ed7b6)},  // 10^323
+  {UINT64_2PART_C(0x9e19db92, b4e31ba9), UINT64_2PART_C(0x6c07a2c2, 6a8346d2)},  // 10^324
+  {UINT64_2PART_C(0xc5a05277, 621be293), UINT64_2PART_C(0xc7098b73, 05241886)},  // 10^325
+  {UINT64_2PART_C(0xf7086715, 3aa2db38), UINT64_2PART_C(0xb8cbee4f, c66d1ea8)},  // 10^326
+
+};
+
+
+// Returns the high 64 bits of the 128-bit product a * b, and stores the
+// low 64 bits in *low.
+static uint64_t MultiplyHigh(uint64_t a, uint64_t b, uint64_t* low) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *low = static_cast<uint64_t>(product);
+  return static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_lo = a & 0xFFFFFFFF;
+  uint64_t a_hi = a >> 32;
+  uint64_t b_lo = b & 0xFFFFFFFF;
+  uint64_t b_hi = b >> 32;
+  uint64_t lo_lo = a_lo * b_lo;
+  uint64_t hi_lo = a_hi * b_lo;
+  uint64_t lo_hi = a_lo * b_hi;
+  uint64_t hi_hi = a_hi * b_hi;
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  *low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+}
+
+
+// floor(log10(2^e)), and floor(log10(3/4 * 2^e)), for |e| <= 1650.
+static int FloorLog10Pow2(int e, bool three_quarters) {
+  return (e * 1262611 - (three_quarters ? 524031 : 0)) >> 22;
+}
+
+
+// floor(log2(10^e)), for |e| <= 1650.
+static int FloorLog2Pow10(int e) {
+  return (e * 1741647) >> 19;
+}
+
+
+// The top 64 bits of g * cp / 2^64, with the bits below rounded to odd:
+// the lowest bit is set if any of the discarded bits is.
+static uint64_t RoundToOdd(const uint64_t* g, uint64_t cp) {
+  uint64_t x_lo;
+  uint64_t x_hi = MultiplyHigh(g[1], cp, &x_lo);
+  uint64_t y_lo;
+  uint64_t y_hi = MultiplyHigh(g[0], cp, &y_lo);
+  uint64_t z = y_lo + x_hi;
+  uint64_t z_hi = y_hi + (z < y_lo ? 1 : 0);
+  return z_hi | (z > 1 ? 1 : 0);
+}
+
+
+// Computes the decimal significand and exponent of the shortest
+// representation, as in Figure 4 of the paper with the modifications of
+// Figure 6.
+static void ToDecimal(double v, uint64_t* significand, int* exponent) {
+  Double d(v);
+  uint64_t c = d.Significand();
+  int q = d.Exponent();
+
+  if (q <= 0 && -q < Double::kSignificandSize) {
+    // Small integers are exact.
+    uint64_t m = c >> -q;
+    if ((m << -q) == c) {
+      *significand = m;
+      *exponent = 0;
+      return;
+    }
+  }
+
+  bool is_even = (c % 2 == 0);
+  bool lower_boundary_is_closer = d.LowerBoundaryIsCloser();
+
+  // The rounding interval of v, scaled by 4.
+  uint64_t cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+  uint64_t cb = 4 * c;
+  uint64_t cbr = 4 * c + 2;
+
+  int k = FloorLog10Pow2(q, lower_boundary_is_closer);
+  int h = q + FloorLog2Pow10(-k) + 1;
+  ASSERT(1 <= h && h <= 4);
+
+  const uint64_t* g = kSchubfachPowersOfTen[-k - kSchubfachMinDecimalPower];
+  uint64_t vbl = RoundToOdd(g, cbl << h);
+  uint64_t vb = RoundToOdd(g, cb << h);
+  uint64_t vbr = RoundToOdd(g, cbr << h);
+
+  uint64_t lower = vbl + (is_even ? 0 : 1);
+  uint64_t upper = vbr - (is_even ? 0 : 1);
+
+  // One digit less, if exactly one of the two candidates is in the
+  // interval.
+  uint64_t s = vb / 4;
+  if (s >= 10) {
+    uint64_t sp = s / 10;
+    bool up_inside = lower <= 40 * sp;
+    bool wp_inside = 40 * sp + 40 <= upper;
+    if (up_inside != wp_inside) {
+      *significand = sp + (wp_inside ? 1 : 0);
+      *exponent = k + 1;
+      return;
+    }
+  }
+
+  bool u_inside = lower <= 4 * s;
+  bool w_inside = 4 * s + 4 <= upper;
+  if (u_inside != w_inside) {
+    *significand = s + (w_inside ? 1 : 0);
+    *exponent = k;
+    return;
+  }
+
+  // Both are in the interval: take the closer one, or the even one if v is
+  // halfway between them. vb can only equal mid if it is exact, since
+  // rounding to odd leaves inexact values odd.
+  uint64_t mid = 4 * s + 2;
+  bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+  *significand = s + (round_up ? 1 : 0);
+  *exponent = k;
+}
+
+
+void SchubfachDtoa(double v,
+                   Vector<char> buffer,
+                   int* length,
+                   int* decimal_point) {
+  ASSERT(v > 0);
+  ASSERT(!Double(v).IsSpecial());
+
+  uint64_t significand;
+  int exponent;
+  ToDecimal(v, &significand, &exponent);
+  while (significand % 10 == 0) {
+    significand /= 10;
+    exponent++;
+  }
+
+  char digits[kSchubfachMaximalLength];
+  int count = 0;
+  while (significand != 0) {
+    digits[count++] = static_cast<char>('0' + significand % 10);
+    significand /= 10;
+  }
+  for (int i = 0; i < count; ++i) {
+    buffer[i] = digits[count - 1 - i];
+  }
+  buffer[count] = '\0';
+  *length = count;
+  *decimal_point = count + exponent;
+}
+
+}  // namespace double_conversion
@@ -0,0 +1,60 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DOUBLE_CONVERSION_SCHUBFACH_DTOA_H_
+#define DOUBLE_CONVERSION_SCHUBFACH_DTOA_H_
+
+#include "utils.h"
+
+namespace double_conversion {
+
+// Provides the shortest decimal representation of v, using Raffaello
+// Giulietti's Schubfach algorithm ("The Schubfach way to render doubles",
+// 2020). Unlike FastDtoa it never gives up: every input takes a few 128-bit
+// multiplications and no bignum arithmetic.
+// The result should be interpreted as buffer * 10^(point - length).
+//
+// Precondition:
+//   * v must be a strictly positive finite double.
+//
+// The result is the one BignumDtoa computes in BIGNUM_DTOA_SHORTEST mode:
+// the digits are the shortest representation that reads back as v, and of
+// those the closest to v. If two are equally close the one ending in an even
+// digit is chosen.
+// There will be *length digits inside the buffer followed by a null
+// terminator. The buffer must be able to hold kSchubfachMaximalLength + 1
+// characters.
+static const int kSchubfachMaximalLength = 17;
+
+void SchubfachDtoa(double v,
+                   Vector<char> buffer,
+                   int* length,
+                   int* decimal_point);
+
+}  // namespace double_conversion
+
+#endif  // DOUBLE_CONVERSION_SCHUBFACH_DTOA_H_
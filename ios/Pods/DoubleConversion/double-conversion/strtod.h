@@ -40,6 +40,12 @@ double Strtod(Vector<const char> buffer, int exponent);
 // contain a dot or a sign. It must not start with '0', and must not be empty.
 float Strtof(Vector<const char> buffer, int exponent);
 
+// Computes significand*10^exponent, correctly rounded, when significand
+// holds every significant digit of the number. Returns false in the rare
+// cases where that cannot be decided without big numbers; Strtod must be
+// used on the digits then.
+bool StrtodUint64(uint64_t significand, int exponent, double* result);
+
 }  // namespace double_conversion
 
 #endif  // DOUBLE_CONVERSION_STRTOD_H_
@@ -0,0 +1,230 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Compares Strtod and Strtof against the same functions built without the
+// Eisel-Lemire step, where every input the exact-power and DiyFp paths
+// cannot settle is decided with Bignum arithmetic.  The two must agree
+// bit for bit.
+//
+//   cd test
+//   g++ -O2 -I.. -o strtod-compare strtod-compare.cc ../double-conversion/*.cc
+//   ./strtod-compare [iterations per kind] [seed]
+//
+// Exits with status 1 if any result differs.  Building with and without
+// a compiler that has unsigned __int128 covers both 128-bit multiplies.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+
+// The reference, compiled into a namespace of its own.
+#define DOUBLE_CONVERSION_NO_EISEL_LEMIRE
+#define double_conversion double_conversion_reference
+#include "double-conversion/bignum.cc"
+#include "double-conversion/cached-powers.cc"
+#include "double-conversion/diy-fp.cc"
+#include "double-conversion/strtod.cc"
+#undef double_conversion
+#undef DOUBLE_CONVERSION_NO_EISEL_LEMIRE
+
+#undef DOUBLE_CONVERSION_UTILS_H_
+#undef DOUBLE_CONVERSION_STRTOD_H_
+#include "double-conversion/strtod.h"
+
+namespace {
+
+std::mt19937_64 rng;
+long mismatches = 0;
+
+// A decimal number: digits * 10^exponent, digits without leading zeros.
+struct Decimal {
+  std::string digits;
+  int exponent;
+};
+
+// Converts printf's %e output, which has a single digit before the point.
+Decimal FromScientific(const char* text) {
+  Decimal d;
+  const char* p = text;
+  for (; *p != 'e'; ++p) {
+    if (*p >= '0' && *p <= '9') d.digits += *p;
+  }
+  d.exponent = atoi(p + 1) - static_cast<int>(d.digits.size()) + 1;
+  size_t zeros = d.digits.find_first_not_of('0');
+  d.digits.erase(0, zeros == std::string::npos ? d.digits.size() : zeros);
+  return d;
+}
+
+double RandomDouble() {
+  uint64_t bits;
+  do {
+    bits = rng() & ~(static_cast<uint64_t>(1) << 63);
+  } while ((bits >> 52) == 0x7FF);
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+float RandomFloat() {
+  uint32_t bits;
+  do {
+    bits = static_cast<uint32_t>(rng()) & 0x7FFFFFFF;
+  } while ((bits >> 23) == 0xFF);
+  float f;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+void Compare(const Decimal& d) {
+  if (d.digits.empty()) return;
+  double_conversion::Vector<const char> buffer(
+      d.digits.data(), static_cast<int>(d.digits.size()));
+  double_conversion_reference::Vector<const char> reference_buffer(
+      d.digits.data(), static_cast<int>(d.digits.size()));
+
+  double actual = double_conversion::Strtod(buffer, d.exponent);
+  double expected =
+      double_conversion_reference::Strtod(reference_buffer, d.exponent);
+  if (memcmp(&actual, &expected, sizeof(actual)) != 0) {
+    ++mismatches;
+    printf("Strtod %se%d: %.17g, expected %.17g\n",
+           d.digits.c_str(), d.exponent, actual, expected);
+  }
+
+  float actual_float = double_conversion::Strtof(buffer, d.exponent);
+  float expected_float =
+      double_conversion_reference::Strtof(reference_buffer, d.exponent);
+  if (memcmp(&actual_float, &expected_float, sizeof(actual_float)) != 0) {
+    ++mismatches;
+    printf("Strtof %se%d: %.9g, expected %.9g\n",
+           d.digits.c_str(), d.exponent, actual_float, expected_float);
+  }
+}
+
+// The input with its last digit moved one either way, and cut to a few
+// lengths, which lands just either side of the original value.
+void CompareAround(const Decimal& d) {
+  Compare(d);
+  static const size_t kLengths[] = { 17, 19, 20, 40 };
+  for (size_t i = 0; i < ARRAY_SIZE(kLengths); ++i) {
+    if (d.digits.size() <= kLengths[i]) break;
+    Decimal cut = { d.digits.substr(0, kLengths[i]),
+                    d.exponent +
+                        static_cast<int>(d.digits.size() - kLengths[i]) };
+    Compare(cut);
+  }
+  Decimal up = d;
+  up.digits += '1';
+  up.exponent -= 1;
+  Compare(up);
+  Decimal down = d;
+  for (size_t i = down.digits.size(); i-- > 0;) {
+    if (down.digits[i] != '0') {
+      --down.digits[i];
+      break;
+    }
+    down.digits[i] = '9';
+  }
+  down.digits += '9';
+  down.exponent -= 1;
+  size_t zeros = down.digits.find_first_not_of('0');
+  down.digits.erase(0, zeros);
+  Compare(down);
+}
+
+// Shortest and full-precision printed doubles.
+void PrintedDoubles(long n) {
+  char text[64];
+  for (long i = 0; i < n; ++i) {
+    double d = RandomDouble();
+    snprintf(text, sizeof(text), "%.16e", d);
+    Compare(FromScientific(text));
+    snprintf(text, sizeof(text), "%.*e", static_cast<int>(rng() % 17), d);
+    Compare(FromScientific(text));
+  }
+}
+
+// Exact halfway points between neighbouring doubles and floats, which
+// fit in a long double, and the numbers just around them.
+void Halfways(long n) {
+  static char text[1200];
+  for (long i = 0; i < n; ++i) {
+    double d = RandomDouble();
+    double next = nextafter(d, HUGE_VAL);
+    if (next != HUGE_VAL) {
+      long double half = (static_cast<long double>(d) + next) / 2;
+      snprintf(text, sizeof(text), "%.1100Le", half);
+      CompareAround(FromScientific(text));
+    }
+
+    float f = RandomFloat();
+    float next_float = nextafterf(f, HUGE_VALF);
+    if (next_float == HUGE_VALF) continue;
+    double float_half = (static_cast<double>(f) + next_float) / 2;
+    snprintf(text, sizeof(text), "%.1100e", float_half);
+    CompareAround(FromScientific(text));
+  }
+}
+
+// Random digit strings of up to 120 digits across the whole exponent
+// range, denormals and overflow included.
+void RandomDigits(long n) {
+  for (long i = 0; i < n; ++i) {
+    Decimal d;
+    size_t length = 1 + rng() % 120;
+    d.digits += static_cast<char>('1' + rng() % 9);
+    while (d.digits.size() < length) {
+      d.digits += static_cast<char>('0' + rng() % 10);
+    }
+    d.exponent = static_cast<int>(rng() % 700) - 350 -
+                 static_cast<int>(length);
+    Compare(d);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  long n = argc > 1 ? atol(argv[1]) : 1000000;
+  rng.seed(argc > 2 ? strtoull(argv[2], NULL, 10) : 1);
+
+  PrintedDoubles(n);
+  Halfways(n / 10);
+  RandomDigits(n);
+
+  if (mismatches != 0) {
+    printf("%ld mismatches\n", mismatches);
+    return 1;
+  }
+  printf("no mismatches\n");
+  return 0;
+}
@@ -15,12 +15,51 @@
  */
 #include <folly/Conv.h>
 #include <array>
+#include <cstring>
+
+#include <double-conversion/strtod.h>
+
+#include <folly/Bits.h>
 
 namespace folly {
 namespace detail {
 
 namespace {
 
+/**
+ * Loads eight chars into an integer, the first one in the low byte.
+ */
+inline uint64_t loadEightChars(const char* p) {
+  uint64_t chunk;
+  std::memcpy(&chunk, p, sizeof(chunk));
+  return Endian::little(chunk);
+}
+
+/**
+ * Whether the eight chars in chunk are all digits. A byte is a digit
+ * iff its high nibble is 3 and stays 3 after adding 6; carries between
+ * bytes only come out of bytes that fail the first test anyway.
+ */
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+      0x3333333333333333ULL;
+}
+
+/**
+ * The value of eight digits that passed isEightDigits(), computed in
+ * three steps that each combine neighboring groups: pairs of digits,
+ * then pairs of pairs, then the two halves.
+ */
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  chunk -= 0x3030303030303030ULL;
+  chunk = chunk * 10 + (chunk >> 8);
+  return static_cast<uint32_t>(
+      ((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+       ((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >>
+      32);
+}
+
 /**
  * Finds the first non-digit in a string. The number of digits
  * searched depends on the precision of the Tgt integral. Assumes the
@@ -31,10 +70,14 @@ namespace {
  *     if (b >= e || !isdigit(*b)) return b;
  *   }
  *
- *  Complete unrolling marks bottom-line (i.e. entire conversion)
- *  improvements of 20%.
+ * Long runs of digits are skipped eight at a time.
  */
 inline const char* findFirstNonDigit(const char* b, const char* e) {
+  for (; e - b >= 8; b += 8) {
+    if (!isEightDigits(loadEightChars(b))) {
+      break;
+    }
+  }
   for (; b < e; ++b) {
     auto const c = static_cast<unsigned>(*b) - '0';
     if (c >= 10) {
@@ -255,8 +298,142 @@ inline bool bool_str_cmp(const char** b, size_t len, const char* value) {
   return true;
 }
 
+// More significant digits than this don't fit in a uint64_t.
+constexpr int kMaxFastDecimalDigits = 19;
+
+/**
+ * Reads the digits at b into *significand, counting them in *digits,
+ * and returns the first non-digit. Stops early, with *digits past
+ * kMaxFastDecimalDigits, if there are too many.
+ */
+inline const char* readDecimalDigits(
+    const char* b,
+    const char* e,
+    uint64_t* significand,
+    int* digits) {
+  auto value = *significand;
+  auto count = *digits;
+  for (; e - b >= 8 && count <= kMaxFastDecimalDigits - 8; b += 8) {
+    const auto chunk = loadEightChars(b);
+    if (!isEightDigits(chunk)) {
+      break;
+    }
+    value = value * 100000000 + parseEightDigits(chunk);
+    count += 8;
+  }
+  for (; b < e; ++b) {
+    auto const c = static_cast<unsigned>(*b) - '0';
+    if (c >= 10) {
+      break;
+    }
+    if (++count > kMaxFastDecimalDigits) {
+      break;
+    }
+    value = value * 10 + c;
+  }
+  *significand = value;
+  *digits = count;
+  return b;
+}
+
+/**
+ * Converts a plain decimal number at the start of [b, e): an optional
+ * sign, digits with an optional fraction, and an optional exponent, with
+ * no spaces. The digits are read straight into a uint64_t rather than
+ * copied out, as StringToDoubleConverter does.
+ *
+ * Returns the number of chars converted, as StringToDoubleConverter
+ * would with ALLOW_TRAILING_JUNK, or 0 if the input is anything else,
+ * has more than 19 significant digits, or is one of the rare numbers
+ * that need double_conversion::Strtod.
+ */
+inline size_t decimalToDouble(
+    const char* const b,
+    const char* const e,
+    double* result) {
+  auto p = b;
+  bool negative = false;
+  if (p < e && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  uint64_t significand = 0;
+  int digits = 0;
+  int exponent = 0;
+  auto const integer = p;
+  while (p < e && *p == '0') {
+    ++p;
+  }
+  p = readDecimalDigits(p, e, &significand, &digits);
+  bool anyDigits = p != integer;
+
+  if (p < e && *p == '.') {
+    auto const fraction = ++p;
+    if (digits == 0) {
+      while (p < e && *p == '0') {
+        ++p;
+      }
+    }
+    p = readDecimalDigits(p, e, &significand, &digits);
+    exponent = -static_cast<int>(p - fraction);
+    anyDigits = anyDigits || p != fraction;
+  }
+
+  if (!anyDigits || digits > kMaxFastDecimalDigits) {
+    return 0;
+  }
+
+  if (p < e && (*p == 'e' || *p == 'E')) {
+    auto q = p + 1;
+    bool negativeExponent = false;
+    if (q < e && (*q == '-' || *q == '+')) {
+      negativeExponent = *q == '-';
+      ++q;
+    }
+    // StringToDoubleConverter counts a dangling "e" or "e-" as
+    // converted; leave that to it.
+    if (q == e || static_cast<unsigned>(*q) - '0' >= 10) {
+      return 0;
+    }
+    int value = 0;
+    for (; q < e; ++q) {
+      auto const c = static_cast<unsigned>(*q) - '0';
+      if (c >= 10) {
+        break;
+      }
+      // Anything this large over- or underflows regardless
+      if (value < 100000) {
+        value = value * 10 + c;
+      }
+    }
+    exponent += negativeExponent ? -value : value;
+    p = q;
+  }
+
+  if (!double_conversion::StrtodUint64(significand, exponent, result)) {
+    return 0;
+  }
+  if (negative) {
+    *result = -*result;
+  }
+  return p - b;
+}
+
 } // anonymous namespace
 
+const char kDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 Expected<bool, ConversionCode> str_to_bool(StringPiece* src) noexcept {
   auto b = src->begin(), e = src->end();
   for (;; ++b) {
@@ -348,6 +525,13 @@ Expected<Tgt, ConversionCode> str_to_floating(StringPiece* src) noexcept {
     return makeUnexpected(ConversionCode::EMPTY_INPUT_STRING);
   }
 
+  double value;
+  if (auto const converted =
+          decimalToDouble(src->begin(), src->end(), &value)) {
+    src->advance(converted);
+    return value;
+  }
+
   int length;
   auto result = conv.StringToDouble(src->data(),
                                     static_cast<int>(src->size()),
@@ -548,6 +732,15 @@ inline Expected<Tgt, ConversionCode> digits_to(
 
   UT result = 0;
 
+  // Eight digits at a time while we can, then four with the tables
+  for (; e - b >= 8; b += 8) {
+    const auto chunk = loadEightChars(b);
+    if (!isEightDigits(chunk)) {
+      goto outOfRange;
+    }
+    result = result * 100000000 + parseEightDigits(chunk);
+  }
+
   for (; e - b >= 4; b += 4) {
     result *= 10000;
     const int32_t r0 = shift1000[static_cast<size_t>(b[0])];
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * A compact binary encoding of dynamic, for exchanging values between
+ * processes or caching them on disk where nobody needs to read json.
+ * Unlike json it round-trips every dynamic exactly: doubles are stored
+ * bit for bit, and object keys may have any type.
+ *
+ *   std::string bytes = toBinary(value);
+ *   dynamic copy = parseBinary(bytes);
+ *
+ * Every value starts with a tag byte:
+ *
+ *   0x00             null
+ *   0x01, 0x02       false, true
+ *   0x03 <varint>    int64, zigzag encoded
+ *   0x04 <8 bytes>   double, IEEE 754, little endian
+ *   0x05 <varint n>  string of n bytes, which follow
+ *   0x06 <varint n>  array of n values, which follow
+ *   0x07 <varint n>  object of n items, which follow as key, value
+ *   0x80 | i         int64 i, for 0 <= i < 128
+ *
+ * Varints are as in folly/Varint.h.  The format is stable; new tags may
+ * be added, but existing ones will keep their meaning.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+
+namespace folly {
+
+struct BinaryParseError : std::runtime_error {
+  explicit BinaryParseError(std::string const& what)
+      : std::runtime_error("dynamic binary parse error: " + what) {}
+};
+
+/*
+ * Encode value, appending to out.
+ */
+void toBinary(dynamic const& value, std::string& out);
+std::string toBinary(dynamic const& value);
+
+/*
+ * Decode a value encoded by toBinary().  Throws BinaryParseError on
+ * malformed input, trailing bytes included, or if containers are nested
+ * deeper than recursionLimit.
+ */
+dynamic parseBinary(ByteRange data, unsigned recursionLimit = 100);
+inline dynamic parseBinary(StringPiece data, unsigned recursionLimit = 100) {
+  return parseBinary(ByteRange(data), recursionLimit);
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Structural diffs of dynamics, as JSON Patch (RFC 6902) documents.
+ *
+ * Sending what changed in a large value, rather than all of it:
+ *
+ *   dynamic patch = jsonDiff(lastSent, state);
+ *   if (!patch.empty()) {
+ *     send(toJson(patch));
+ *     lastSent = state;
+ *   }
+ *
+ * and on the other end:
+ *
+ *   applyJsonPatch(state, parseJson(message));
+ *
+ * jsonDiff() visits each value at most a few times.  Unchanged parts
+ * are recognized by operator==, which gives up at the first difference;
+ * in FOLLY_DYNAMIC_COPY_ON_WRITE builds, parts that a copy still shares
+ * with its original are recognized without being looked at, so diffing
+ * a value against an earlier copy of itself costs in proportion to what
+ * changed.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include <folly/dynamic.h>
+
+namespace folly {
+
+struct JsonPatchError : std::runtime_error {
+  explicit JsonPatchError(std::string const& what)
+      : std::runtime_error("json patch error: " + what) {}
+};
+
+/*
+ * Returns a patch, an array of operations, that turns from into to.
+ * The patch is empty if the two are equal.  It only uses the "add",
+ * "remove" and "replace" operations.
+ *
+ * Arrays are compared element by element, after skipping the elements
+ * they start and end with in common, so inserting or removing a run of
+ * elements in one place makes for a short patch.  Throws TypeError if
+ * the objects that differ have keys other than strings.
+ */
+dynamic jsonDiff(dynamic const& from, dynamic const& to);
+
+/*
+ * Apply the operations of patch to doc, in order.  All six operations of
+ * RFC 6902 are supported.  Throws JsonPatchError if an operation is
+ * malformed, refers to a value that does not exist, or is a "test" that
+ * fails, and JsonPathError if a path is not a valid JSON Pointer.
+ *
+ * doc is left with the operations before the failing one applied.
+ * Apply the patch to a copy to get all or nothing; in copy-on-write
+ * builds the copy only duplicates the containers the patch changes.
+ */
+void applyJsonPatch(dynamic& doc, dynamic const& patch);
+
+}
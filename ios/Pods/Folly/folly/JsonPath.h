@@ -0,0 +1,145 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Precompiled paths into json documents.
+ *
+ * A JsonPath is parsed once, from a JSON Pointer (RFC 6901) or from a
+ * small subset of JSONPath, into a vector of tokens whose keys are
+ * ready-made dynamics (and, with FOLLY_DYNAMIC_FLAT_OBJECTS, already
+ * hashed), so evaluating it does no string handling at all:
+ *
+ *   static auto const kName = JsonPath::fromPointer("/user/name");
+ *   if (auto* name = kName.get_ptr(message)) {
+ *     ...
+ *   }
+ *
+ * The JSONPath subset is the root "$" followed by any number of
+ *
+ *   .name  ['name']  ["name"]   an object member
+ *   [3]                         an array element
+ *   .*  [*]                     every member or element
+ *
+ * A path can also be evaluated while parsing, with selectFromJson().
+ * Containers the path does not lead into are skipped by the parser
+ * without being built, and only the matching values become dynamics,
+ * which makes pulling a few fields out of a large message much cheaper
+ * than parseJson() followed by get_ptr().
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+namespace folly {
+
+//////////////////////////////////////////////////////////////////////
+
+struct JsonPathError : std::runtime_error {
+  explicit JsonPathError(std::string const& msg) : std::runtime_error(msg) {}
+};
+
+class JsonPath {
+ public:
+  struct Token {
+    enum class Kind {
+      // A member of an object.
+      Key,
+      // An element of an array.
+      Index,
+      // A JSON Pointer reference token: a member of an object, or an
+      // element of an array if the token is an array index.
+      KeyOrIndex,
+      // Every member or element.
+      Wildcard,
+    };
+
+    Kind kind;
+    // The member name, for Key and KeyOrIndex tokens.
+    dynamic key;
+    // DynamicFlatHash of key, in FOLLY_DYNAMIC_FLAT_OBJECTS builds.
+    uint64_t hash;
+    // The array index, if hasIndex.  A pointer's "-" (the element past
+    // the end of an array) has no index.
+    std::size_t index;
+    bool hasIndex;
+  };
+
+  // The empty path, which refers to the whole document.
+  JsonPath() {}
+
+  /*
+   * Parse a JSON Pointer such as "/a/b~1c/0", or a path in the JSONPath
+   * subset described above, such as "$.a['b/c'][0]".  Throws
+   * JsonPathError if the syntax is invalid.
+   */
+  static JsonPath fromPointer(StringPiece pointer);
+  static JsonPath fromJsonPath(StringPiece path);
+
+  std::vector<Token> const& tokens() const { return tokens_; }
+  bool empty() const { return tokens_.empty(); }
+  // Whether the path can match more than one value.
+  bool hasWildcard() const;
+
+  /*
+   * The first value the path refers to, in iteration order, or nullptr
+   * if there is none.  Never throws for a path that leads nowhere, be it
+   * to a missing member, an index out of range, or into a scalar.
+   *
+   * The non-const version copies shared arrays and objects on the way
+   * in copy-on-write builds.
+   */
+  dynamic const* get_ptr(dynamic const& root) const;
+  dynamic* get_ptr(dynamic& root) const;
+
+  /*
+   * Every value the path refers to, in iteration order.
+   */
+  std::vector<dynamic const*> select(dynamic const& root) const;
+
+  /*
+   * Parse a json document, building only the values the path refers to,
+   * in document order.  Takes the same options and throws the same
+   * errors as parseJson(); the document is checked in full, including
+   * the parts that are skipped.  Unlike with parseJson(), every
+   * occurrence of a duplicate key matches.
+   */
+  std::vector<dynamic> selectFromJson(
+      StringPiece json,
+      json::serialization_opts const& opts = json::serialization_opts()) const;
+
+ private:
+  void addToken(Token::Kind kind, std::string&& key);
+  static dynamic const* child(dynamic const& parent, Token const& token);
+
+  // Calls fn on each value the path refers to below node, which is at
+  // the given depth, until fn returns false.
+  template <class D, class Fn>
+  bool visit(D& node, std::size_t depth, Fn& fn) const;
+
+  std::vector<Token> tokens_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}
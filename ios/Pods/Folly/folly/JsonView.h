@@ -0,0 +1,230 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Zero-copy, read-only json parsing.
+ *
+ * parseJsonView() parses the same documents parseJson() does, but
+ * instead of a dynamic it produces a JsonDocument: a tree of JsonViews
+ * whose strings point straight into the input buffer.  Only strings
+ * that contain escape sequences have to be decoded, and those are the
+ * only strings that get copied.  All nodes of a document live in one
+ * contiguous allocation.
+ *
+ * The input buffer must outlive the document and every view into it.
+ *
+ *   auto doc = parseJsonView(message);
+ *   if (auto* user = doc.root().get_ptr("user")) {
+ *     StringPiece name = (*user)["name"].getString();
+ *   }
+ *
+ * Use toDynamic() to get a mutable copy of (part of) the document.
+ *
+ * Documents made of many objects with the same keys, such as arrays of
+ * records, can be parsed with JsonObjectLayout::SharedKeys.  Each
+ * distinct sequence of keys is then stored once per document, as a
+ * "shape" the objects refer to, and objects only store their values.
+ * That halves the nodes such a document needs, and lookups in wide
+ * objects go through an index built once per shape.  The JsonView
+ * interface is the same either way.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Hash.h>
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+namespace folly {
+
+class JsonDocument;
+
+namespace detail {
+struct JsonShape;
+struct JsonViewBuilder;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+class JsonView {
+ public:
+  typedef dynamic::Type Type;
+
+  Type type() const { return type_; }
+
+  bool isNull() const { return type_ == dynamic::NULLT; }
+  bool isArray() const { return type_ == dynamic::ARRAY; }
+  bool isBool() const { return type_ == dynamic::BOOL; }
+  bool isDouble() const { return type_ == dynamic::DOUBLE; }
+  bool isInt() const { return type_ == dynamic::INT64; }
+  bool isObject() const { return type_ == dynamic::OBJECT; }
+  bool isString() const { return type_ == dynamic::STRING; }
+  bool isNumber() const { return isInt() || isDouble(); }
+
+  /*
+   * Extract the value without type conversion.  These throw TypeError
+   * if the view has a different type.  The StringPiece returned by
+   * getString() is valid as long as the document and its input are.
+   */
+  StringPiece getString() const;
+  double getDouble() const;
+  int64_t getInt() const;
+  bool getBool() const;
+
+  /*
+   * If this is an array or an object, returns the number of elements
+   * contained.  If it is a string, returns the length.  Otherwise
+   * throws TypeError.
+   */
+  std::size_t size() const;
+  bool empty() const;
+
+  /*
+   * Array access.  The index operator throws std::out_of_range for
+   * indexes past the end; all of these throw TypeError on non-arrays.
+   */
+  JsonView const* begin() const;
+  JsonView const* end() const;
+  JsonView const& operator[](std::size_t index) const;
+
+  /*
+   * Object access by key.  Lookup is a linear scan, which beats hashing
+   * for the small objects that make up most messages.  If a key occurs
+   * more than once the last occurrence wins, as in parseJson().
+   *
+   * get_ptr() returns nullptr if the key is not present; the index
+   * operator throws std::out_of_range instead.  Both throw TypeError on
+   * non-objects.
+   */
+  JsonView const* get_ptr(StringPiece key) const;
+  JsonView const& operator[](StringPiece key) const;
+
+  /*
+   * Positional access to the items of an object, in document order
+   * (duplicate keys included), for i < size().
+   */
+  JsonView const& keyAt(std::size_t i) const;
+  JsonView const& valueAt(std::size_t i) const;
+
+  /*
+   * Deep copy into a dynamic.
+   */
+  dynamic toDynamic() const;
+
+ private:
+  friend class JsonDocument;
+  friend struct detail::JsonViewBuilder;
+
+  JsonView()
+      : type_(dynamic::NULLT), sharedKeys_(false), size_(0), integer_(0) {}
+
+  void requireType(Type type, char const* name) const;
+
+  // For objects with shared keys, the node before the values holds the
+  // shape.
+  detail::JsonShape const& shape() const { return *children_[-1].shape_; }
+
+  Type type_;
+  // Whether this object's keys are in its shape (see JsonShape) rather
+  // than alternating with its values.
+  bool sharedKeys_;
+  // Number of characters of a string, of elements of an array, or of
+  // child nodes of an object: twice the number of items, unless the keys
+  // are shared.
+  std::size_t size_;
+  union {
+    bool boolean_;
+    int64_t integer_;
+    double double_;
+    char const* string_;
+    JsonView const* children_;
+    detail::JsonShape const* shape_;
+    // Offset of the first child in the document while it is built.
+    std::size_t childIndex_;
+  };
+};
+
+namespace detail {
+
+// hasher<StringPiece> needs SpookyHashV2.cpp, which not all builds have.
+struct JsonKeyHash {
+  std::size_t operator()(StringPiece key) const {
+    return hash::fnv64_buf(key.data(), key.size());
+  }
+};
+
+// The keys shared by objects parsed with JsonObjectLayout::SharedKeys.
+struct JsonShape {
+  std::vector<JsonView> keys;
+  // Index of the last occurrence of each key, for shapes too wide for a
+  // linear scan; empty otherwise.
+  std::unordered_map<StringPiece, std::size_t, JsonKeyHash> index;
+};
+
+}
+
+/*
+ * Owns the nodes of a parsed JsonView tree and the decoded copies of
+ * any strings that contained escapes.  Movable but not copyable.
+ */
+class JsonDocument {
+ public:
+  JsonDocument(JsonDocument&&) = default;
+  JsonDocument& operator=(JsonDocument&&) = default;
+  JsonDocument(JsonDocument const&) = delete;
+  JsonDocument& operator=(JsonDocument const&) = delete;
+
+  JsonView const& root() const { return nodes_.back(); }
+
+ private:
+  friend struct detail::JsonViewBuilder;
+
+  JsonDocument() {}
+
+  // Children of a node are contiguous and precede it; the root is last.
+  std::vector<JsonView> nodes_;
+  // Deques so that adding strings or shapes never moves existing ones.
+  std::deque<std::string> strings_;
+  std::deque<detail::JsonShape> shapes_;
+};
+
+enum class JsonObjectLayout {
+  // Keys and values of each object are stored together.
+  Inline,
+  // Objects with the same string keys in the same order share them.
+  SharedKeys,
+};
+
+/*
+ * Parse a json blob into a JsonDocument referring back into it.  Takes
+ * the same options and throws the same errors as parseJson().
+ */
+JsonDocument parseJsonView(
+    StringPiece,
+    json::serialization_opts const&,
+    JsonObjectLayout layout = JsonObjectLayout::Inline);
+JsonDocument parseJsonView(StringPiece);
+
+//////////////////////////////////////////////////////////////////////
+
+}
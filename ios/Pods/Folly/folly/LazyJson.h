@@ -0,0 +1,294 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Json parsing that only decodes the parts of a document that are used.
+ *
+ * Constructing a LazyJson makes one pass over the input that records
+ * where each value starts and ends, on a "tape" of a few integers per
+ * value, without converting any numbers, decoding any strings or
+ * building any dynamics.  Values are decoded into dynamics the first
+ * time they are asked for, and kept for later:
+ *
+ *   LazyJson doc(message);
+ *   if (auto user = doc.root().get("user")) {
+ *     dynamic const& name = (*user)["name"].value();
+ *   }
+ *
+ * Finding a member or element on the tape skips over the values before
+ * it without looking inside them, so a message that is mostly passed
+ * over costs little more than the first pass.  To visit every element
+ * or member, iterate rather than index:
+ *
+ *   for (auto record : doc.root()) {
+ *     for (auto item : record.items()) {
+ *       ... item.first.value() ... item.second.raw() ...
+ *     }
+ *   }
+ *
+ * The first pass checks the structure of the document: brackets,
+ * quotes, commas and colons.  Mistakes inside a number or a string,
+ * such as a bad escape, are only found when that value is decoded.
+ * Either way the error is a json::ParseError, though not always the one
+ * parseJson() would throw for the same text: the first pass counts every
+ * newline, where parseJson() only counts those inside strings, and it
+ * describes a misplaced bracket, comma or colon in its own terms.
+ *
+ * The input must outlive the LazyJson.  Refs are invalidated by moving
+ * the LazyJson.  Since decoding fills in a cache, a LazyJson must not be
+ * used from several threads at once, even through const methods.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <folly/Optional.h>
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+namespace folly {
+
+namespace detail {
+struct LazyJsonScanner;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+class LazyJson {
+ public:
+  /*
+   * A value in the document.  Cheap to copy.
+   */
+  class Ref {
+   public:
+    class const_iterator;
+    class const_item_iterator;
+    struct Items;
+
+    bool isArray() const;
+    bool isObject() const;
+    // Decodes scalars.
+    dynamic::Type type() const;
+
+    /*
+     * The number of elements of an array or items of an object.  Throws
+     * TypeError for anything else.
+     */
+    std::size_t size() const;
+
+    /*
+     * Array access.  Finding element i skips the i elements before it,
+     * so walk arrays with begin() and end() instead.  Throws
+     * std::out_of_range for indexes past the end, and TypeError on
+     * non-arrays.
+     */
+    Ref operator[](std::size_t index) const;
+
+    /*
+     * The elements of an array, in order.  Throws TypeError on
+     * non-arrays.
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /*
+     * The (key, value) pairs of an object, in document order, including
+     * every occurrence of a duplicate key.  Throws TypeError on
+     * non-objects.
+     */
+    Items items() const;
+
+    /*
+     * Object access by key.  If a key occurs more than once the last
+     * occurrence wins, as in parseJson().  get() returns none if the key
+     * is not present; the index operator throws std::out_of_range
+     * instead.  Both throw TypeError on non-objects.
+     */
+    Optional<Ref> get(StringPiece key) const;
+    Ref operator[](StringPiece key) const;
+
+    /*
+     * The value, decoded the first time it is asked for.
+     */
+    dynamic const& value() const;
+
+    /*
+     * The json text of the value.
+     */
+    StringPiece raw() const;
+
+   private:
+    friend class LazyJson;
+
+    Ref(LazyJson const* doc, uint32_t index) : doc_(doc), index_(index) {}
+
+    void requireType(char bracket, char const* name) const;
+
+    LazyJson const* doc_;
+    uint32_t index_;
+  };
+
+  /*
+   * Scan json, throwing ParseError if its structure is invalid.  Takes
+   * the same options as parseJson().
+   */
+  explicit LazyJson(
+      StringPiece json,
+      json::serialization_opts const& opts = json::serialization_opts());
+
+  LazyJson(LazyJson&&) = default;
+  LazyJson& operator=(LazyJson&&) = default;
+  LazyJson(LazyJson const&) = delete;
+  LazyJson& operator=(LazyJson const&) = delete;
+
+  Ref root() const { return Ref(this, 0); }
+
+ private:
+  friend struct detail::LazyJsonScanner;
+
+  // One per value, in document order, so that the values in a container
+  // follow it on the tape; for an object, its keys and values alternate.
+  struct Entry {
+    // Offsets of the value in the input.
+    uint32_t begin;
+    uint32_t end;
+    // Index of the first entry after the value and everything in it.
+    uint32_t next;
+    // Line the value starts on, for errors.
+    uint32_t line;
+    // Number of elements of an array, or of items of an object.  For a
+    // string, whether it has any escapes.
+    uint32_t size;
+  };
+
+  bool keyEquals(uint32_t key, StringPiece expected) const;
+  dynamic decode(Entry const& entry) const;
+
+  StringPiece text_;
+  json::serialization_opts opts_;
+  std::vector<Entry> tape_;
+  mutable std::unordered_map<uint32_t, dynamic> values_;
+};
+
+class LazyJson::Ref::const_iterator
+    : public std::iterator<std::forward_iterator_tag, Ref, std::ptrdiff_t,
+                           Ref const*, Ref> {
+ public:
+  const_iterator() : doc_(nullptr), index_(0) {}
+
+  Ref operator*() const { return Ref(doc_, index_); }
+
+  const_iterator& operator++() {
+    index_ = doc_->tape_[index_].next;
+    return *this;
+  }
+  const_iterator operator++(int) {
+    auto ret = *this;
+    ++*this;
+    return ret;
+  }
+
+  bool operator==(const_iterator const& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const_iterator const& other) const {
+    return index_ != other.index_;
+  }
+
+ private:
+  friend class Ref;
+
+  const_iterator(LazyJson const* doc, uint32_t index)
+      : doc_(doc), index_(index) {}
+
+  LazyJson const* doc_;
+  uint32_t index_;
+};
+
+class LazyJson::Ref::const_item_iterator
+    : public std::iterator<std::forward_iterator_tag, std::pair<Ref, Ref>,
+                           std::ptrdiff_t, std::pair<Ref, Ref> const*,
+                           std::pair<Ref, Ref>> {
+ public:
+  const_item_iterator() : doc_(nullptr), index_(0) {}
+
+  // The key, then the value that follows it on the tape.
+  std::pair<Ref, Ref> operator*() const {
+    return std::make_pair(
+        Ref(doc_, index_), Ref(doc_, doc_->tape_[index_].next));
+  }
+
+  const_item_iterator& operator++() {
+    index_ = doc_->tape_[doc_->tape_[index_].next].next;
+    return *this;
+  }
+  const_item_iterator operator++(int) {
+    auto ret = *this;
+    ++*this;
+    return ret;
+  }
+
+  bool operator==(const_item_iterator const& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const_item_iterator const& other) const {
+    return index_ != other.index_;
+  }
+
+ private:
+  friend class Ref;
+
+  const_item_iterator(LazyJson const* doc, uint32_t index)
+      : doc_(doc), index_(index) {}
+
+  LazyJson const* doc_;
+  uint32_t index_;
+};
+
+struct LazyJson::Ref::Items {
+  const_item_iterator begin() const { return begin_; }
+  const_item_iterator end() const { return end_; }
+
+  const_item_iterator begin_;
+  const_item_iterator end_;
+};
+
+inline LazyJson::Ref::const_iterator LazyJson::Ref::begin() const {
+  requireType('[', "array");
+  return const_iterator(doc_, index_ + 1);
+}
+
+inline LazyJson::Ref::const_iterator LazyJson::Ref::end() const {
+  requireType('[', "array");
+  return const_iterator(doc_, doc_->tape_[index_].next);
+}
+
+inline LazyJson::Ref::Items LazyJson::Ref::items() const {
+  requireType('{', "object");
+  return Items{const_item_iterator(doc_, index_ + 1),
+               const_item_iterator(doc_, doc_->tape_[index_].next)};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,646 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <folly/Bits.h>
+#include <folly/Hash.h>
+#include <folly/Portability.h>
+
+#if FOLLY_SSE_PREREQ(2, 0)
+#include <emmintrin.h>
+#elif FOLLY_A64 && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace folly {
+
+namespace detail {
+
+/*
+ * A hash map with open addressing, in the style of Abseil's SwissTable,
+ * used for dynamic objects when FOLLY_DYNAMIC_FLAT_OBJECTS is set.
+ *
+ * The items live in one contiguous array, in insertion order, which is
+ * what iteration walks; erasing an item moves the last one into its
+ * place.  Lookups go through a separate index of buckets, each a control
+ * byte plus the position of an item.  A control byte is either empty,
+ * deleted, or holds 7 bits of the key's hash, and a probe compares a
+ * whole group of control bytes against those 7 bits at once (16 with
+ * SSE2 or NEON, 8 with plain 64 bit arithmetic), so keys are only
+ * compared on a likely hit.
+ *
+ * Small maps have no index at all: up to kMaxLinear items are found by
+ * comparing keys one by one, which beats hashing at that size, and the
+ * items array is then the map's only allocation.  Keys are still hashed
+ * when a lookup misses, so that keys Hash rejects (by throwing) are
+ * rejected whatever the size.  KeyEqual must therefore never hold for
+ * keys with different hashes.
+ *
+ * Only the subset of the std::unordered_map interface dynamic needs is
+ * provided.  Unlike std::unordered_map, inserting a new key may
+ * invalidate all iterators and references to items (inserting one that
+ * is already present invalidates none), and erasing invalidates those
+ * to the erased and to the last item.
+ *
+ * Hash must return 64 well mixed bits.  Alloc must be stateless.
+ */
+template <class Key, class Value, class Hash, class KeyEqual, class Alloc>
+class FlatHashMap {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key const, Value> value_type;
+  typedef std::size_t size_type;
+  typedef value_type* iterator;
+  typedef value_type const* const_iterator;
+
+  FlatHashMap() noexcept
+      : items_(nullptr),
+        index_(nullptr),
+        size_(0),
+        itemCapacity_(0),
+        bucketCount_(0),
+        growthLeft_(0) {}
+
+  FlatHashMap(FlatHashMap const& other) : FlatHashMap() {
+    if (other.size_ == 0) {
+      return;
+    }
+    items_ = ItemAlloc().allocate(other.size_);
+    itemCapacity_ = other.size_;
+    try {
+      for (; size_ < other.size_; ++size_) {
+        new (items_ + size_) value_type(other.items_[size_]);
+      }
+      // Same items in the same order, so the index carries over as is.
+      if (other.index_) {
+        index_ = ByteAlloc().allocate(indexBytes(other.bucketCount_));
+        std::memcpy(index_, other.index_, indexBytes(other.bucketCount_));
+        bucketCount_ = other.bucketCount_;
+      }
+    } catch (...) {
+      destroy();
+      throw;
+    }
+    growthLeft_ = other.growthLeft_;
+  }
+
+  FlatHashMap(FlatHashMap&& other) noexcept : FlatHashMap() {
+    swap(other);
+  }
+
+  FlatHashMap& operator=(FlatHashMap const& other) {
+    if (&other != this) {
+      FlatHashMap copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+    if (&other != this) {
+      destroy();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~FlatHashMap() {
+    destroy();
+  }
+
+  void swap(FlatHashMap& other) noexcept {
+    std::swap(items_, other.items_);
+    std::swap(index_, other.index_);
+    std::swap(size_, other.size_);
+    std::swap(itemCapacity_, other.itemCapacity_);
+    std::swap(bucketCount_, other.bucketCount_);
+    std::swap(growthLeft_, other.growthLeft_);
+  }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator begin() { return items_; }
+  iterator end() { return items_ + size_; }
+  const_iterator begin() const { return items_; }
+  const_iterator end() const { return items_ + size_; }
+
+  iterator find(Key const& key) {
+    std::size_t found;
+    if (index_) {
+      found = findIndex(key, Hash()(key));
+    } else {
+      found = findLinear(key);
+      if (found == kNotFound) {
+        Hash()(key);
+      }
+    }
+    return found == kNotFound ? end() : items_ + found;
+  }
+
+  const_iterator find(Key const& key) const {
+    return const_cast<FlatHashMap*>(this)->find(key);
+  }
+
+  // For callers that look the same key up many times: hash must be
+  // Hash()(key), computed once up front.
+  const_iterator find(Key const& key, uint64_t hash) const {
+    std::size_t found = index_ ? findIndex(key, hash) : findLinear(key);
+    return found == kNotFound ? end() : items_ + found;
+  }
+
+  size_type count(Key const& key) const {
+    return find(key) != end();
+  }
+
+  /*
+   * Like std::unordered_map::insert(): the item is constructed first
+   * and then discarded if its key is already present.
+   */
+  std::pair<iterator, bool> insert(value_type&& item) {
+    return emplace(std::move(item));
+  }
+
+  template <class P>
+  std::pair<iterator, bool> insert(P&& item) {
+    return emplace(std::forward<P>(item));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if (size_ < itemCapacity_) {
+      // Built in place, and destroyed again if its key is already present.
+      value_type* item = items_ + size_;
+      new (item) value_type(std::forward<Args>(args)...);
+      try {
+        uint64_t hash;
+        std::size_t found = findForInsert(item->first, hash);
+        if (found != kNotFound) {
+          item->~value_type();
+          return std::make_pair(items_ + found, false);
+        }
+        reserveBucket();
+        if (index_) {
+          claimBucket(hash, size_);
+        }
+      } catch (...) {
+        item->~value_type();
+        throw;
+      }
+      ++size_;
+      return std::make_pair(item, true);
+    }
+
+    // Full, so the item is built aside: the items are only moved once
+    // its key turns out to be new, and args may refer to one of them.
+    value_type item(std::forward<Args>(args)...);
+    uint64_t hash;
+    std::size_t found = findForInsert(item.first, hash);
+    if (found != kNotFound) {
+      return std::make_pair(items_ + found, false);
+    }
+    reserveBucket();
+    growItems();
+    new (items_ + size_) value_type(
+        std::move(const_cast<Key&>(item.first)), std::move(item.second));
+    if (index_) {
+      claimBucket(hash, size_);
+    }
+    return std::make_pair(items_ + size_++, true);
+  }
+
+  size_type erase(Key const& key) {
+    auto it = find(key);
+    if (it == end()) {
+      return 0;
+    }
+    erase(it);
+    return 1;
+  }
+
+  /*
+   * Returns an iterator to the item that took the erased one's place,
+   * which has not been visited yet by a loop that erases as it goes.
+   */
+  iterator erase(const_iterator pos) {
+    std::size_t i = pos - items_;
+    std::size_t last = size_ - 1;
+    if (index_) {
+      releaseBucket(findBucket(i));
+    }
+    if (i != last) {
+      if (index_) {
+        slots()[findBucket(last)] = i;
+      }
+      items_[i].~value_type();
+      relocate(items_ + i, items_ + last);
+    } else {
+      items_[i].~value_type();
+    }
+    --size_;
+    return items_ + i;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    // Back to front, so that every item moved into the range comes from
+    // past its end.
+    for (auto it = last; it != first; ) {
+      erase(--it);
+    }
+    return items_ + (first - items_);
+  }
+
+  /*
+   * Equal if both have the same keys, mapped to equal values; order
+   * does not matter.
+   */
+  bool operator==(FlatHashMap const& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    for (auto& item : *this) {
+      auto it = other.find(item.first);
+      if (it == other.end() || !(it->second == item.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(FlatHashMap const& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  typedef typename std::allocator_traits<Alloc>::template rebind_alloc<
+      value_type> ItemAlloc;
+  typedef typename std::allocator_traits<Alloc>::template rebind_alloc<
+      char> ByteAlloc;
+
+  static_assert(std::is_empty<Alloc>::value, "Alloc must be stateless");
+
+  // The control bytes of a group of consecutive buckets, and the
+  // bitmasks of those matching a condition.  A mask has one bit set per
+  // matching bucket, at (bucket << kShift) plus some constant.
+  struct Group {
+#if FOLLY_SSE_PREREQ(2, 0)
+    static constexpr std::size_t kWidth = 16;
+    static constexpr unsigned kShift = 0;
+
+    explicit Group(uint8_t const* ctrl)
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {}
+
+    uint64_t match(uint8_t h2) const {
+      return _mm_movemask_epi8(
+          _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(static_cast<char>(h2))));
+    }
+    uint64_t matchEmpty() const {
+      return _mm_movemask_epi8(
+          _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(static_cast<char>(kEmpty))));
+    }
+    uint64_t matchEmptyOrDeleted() const {
+      return _mm_movemask_epi8(ctrl_);
+    }
+
+    __m128i ctrl_;
+#elif FOLLY_A64 && defined(__ARM_NEON)
+    static constexpr std::size_t kWidth = 16;
+    static constexpr unsigned kShift = 2;
+
+    explicit Group(uint8_t const* ctrl) : ctrl_(vld1q_u8(ctrl)) {}
+
+    // NEON has no movemask; narrowing each byte to a nibble gives a
+    // 64 bit mask instead, of which we keep the top bit of every nibble.
+    static uint64_t toMask(uint8x16_t lanes) {
+      uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+      return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) &
+          0x8888888888888888ULL;
+    }
+
+    uint64_t match(uint8_t h2) const {
+      return toMask(vceqq_u8(ctrl_, vdupq_n_u8(h2)));
+    }
+    uint64_t matchEmpty() const {
+      return toMask(vceqq_u8(ctrl_, vdupq_n_u8(kEmpty)));
+    }
+    uint64_t matchEmptyOrDeleted() const {
+      return toMask(vcltzq_s8(vreinterpretq_s8_u8(ctrl_)));
+    }
+
+    uint8x16_t ctrl_;
+#else
+    static constexpr std::size_t kWidth = 8;
+    static constexpr unsigned kShift = 3;
+    static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+    explicit Group(uint8_t const* ctrl) {
+      std::memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+      ctrl_ = Endian::little(ctrl_);
+    }
+
+    // May report a full bucket next to a match that does not match; the
+    // caller compares keys anyway.
+    uint64_t match(uint8_t h2) const {
+      uint64_t x = ctrl_ ^ (kLsbs * h2);
+      return (x - kLsbs) & ~x & kMsbs;
+    }
+    // Empty is the only control byte with the top bit set and bit 1
+    // clear.
+    uint64_t matchEmpty() const {
+      return ctrl_ & ~(ctrl_ << 6) & kMsbs;
+    }
+    uint64_t matchEmptyOrDeleted() const {
+      return ctrl_ & kMsbs;
+    }
+
+    uint64_t ctrl_;
+#endif
+
+    static std::size_t lowest(uint64_t mask) {
+      return (findFirstSet(mask) - 1) >> kShift;
+    }
+  };
+
+  static constexpr uint8_t kEmpty = 0x80;
+  static constexpr uint8_t kDeleted = 0xfe;
+  static constexpr std::size_t kMinBuckets = 16;
+  static constexpr std::size_t kMaxLinear = 8;
+  static constexpr std::size_t kNotFound = std::size_t(-1);
+  static constexpr std::size_t kContinue = std::size_t(-2);
+
+  // The top 7 bits go into the control byte, the bottom ones pick the
+  // first group to probe.
+  static uint8_t h2(uint64_t hash) { return hash >> 57; }
+
+  static std::size_t indexBytes(std::size_t buckets) {
+    return buckets * (sizeof(uint32_t) + 1);
+  }
+
+  // At most 7/8 of the buckets may be in use, so that probes end soon.
+  static std::size_t maxLoad(std::size_t buckets) {
+    return buckets - buckets / 8;
+  }
+
+  static std::size_t bucketCountFor(std::size_t items) {
+    std::size_t buckets = kMinBuckets;
+    while (maxLoad(buckets) < items) {
+      buckets *= 2;
+    }
+    return buckets;
+  }
+
+  uint32_t* slots() const { return reinterpret_cast<uint32_t*>(index_); }
+  uint8_t* ctrl() const {
+    return reinterpret_cast<uint8_t*>(index_) +
+        bucketCount_ * sizeof(uint32_t);
+  }
+
+  // Visits groups in triangular order, which covers all of them since
+  // the number of groups is a power of two, until visit returns something
+  // other than kContinue.
+  template <class F>
+  std::size_t probe(uint64_t hash, F&& visit) const {
+    std::size_t groupMask = bucketCount_ / Group::kWidth - 1;
+    std::size_t group = static_cast<std::size_t>(hash) & groupMask;
+    for (std::size_t step = 1;; ++step) {
+      std::size_t first = group * Group::kWidth;
+      std::size_t found = visit(first, Group(ctrl() + first));
+      if (found != kContinue) {
+        return found;
+      }
+      group = (group + step) & groupMask;
+    }
+  }
+
+  // Position of the item with the given key, or kNotFound, for maps
+  // without an index.
+  std::size_t findLinear(Key const& key) const {
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (KeyEqual()(items_[i].first, key)) {
+        return i;
+      }
+    }
+    return kNotFound;
+  }
+
+  // Position of the item with the given key, or kNotFound.  Requires an
+  // index.
+  std::size_t findIndex(Key const& key, uint64_t hash) const {
+    uint8_t tag = h2(hash);
+    return probe(hash, [&](std::size_t first, Group group) -> std::size_t {
+      for (auto mask = group.match(tag); mask; mask &= mask - 1) {
+        uint32_t i = slots()[first + Group::lowest(mask)];
+        if (KeyEqual()(items_[i].first, key)) {
+          return i;
+        }
+      }
+      // A key is never stored past a group with room in it.
+      if (group.matchEmpty()) {
+        return kNotFound;
+      }
+      return kContinue;
+    });
+  }
+
+  // Position of the item with the given key, or kNotFound, in which case
+  // hash is set to the key's hash.
+  std::size_t findForInsert(Key const& key, uint64_t& hash) const {
+    std::size_t found = index_ ? kNotFound : findLinear(key);
+    if (found == kNotFound) {
+      hash = Hash()(key);
+      if (index_) {
+        found = findIndex(key, hash);
+      }
+    }
+    return found;
+  }
+
+  // Makes sure the index has a bucket for one more item, building it
+  // once the map outgrows linear search.
+  void reserveBucket() {
+    if (index_ ? growthLeft_ == 0 : size_ >= kMaxLinear) {
+      rehash(bucketCountFor(2 * (size_ + 1)));
+    }
+  }
+
+  // The bucket holding item i.
+  std::size_t findBucket(std::size_t i) const {
+    uint64_t hash = Hash()(items_[i].first);
+    uint8_t tag = h2(hash);
+    return probe(hash, [&](std::size_t first, Group group) -> std::size_t {
+      for (auto mask = group.match(tag); mask; mask &= mask - 1) {
+        std::size_t bucket = first + Group::lowest(mask);
+        if (slots()[bucket] == i) {
+          return bucket;
+        }
+      }
+      return kContinue;
+    });
+  }
+
+  void claimBucket(uint64_t hash, std::size_t i) {
+    std::size_t bucket =
+        probe(hash, [](std::size_t first, Group group) -> std::size_t {
+          auto mask = group.matchEmptyOrDeleted();
+          return mask ? first + Group::lowest(mask) : kContinue;
+        });
+    if (ctrl()[bucket] == kEmpty) {
+      --growthLeft_;
+    }
+    ctrl()[bucket] = h2(hash);
+    slots()[bucket] = i;
+  }
+
+  void releaseBucket(std::size_t bucket) {
+    // Probes only ever pass groups that were full when they did, and a
+    // group that has been full gets no empty buckets back until the next
+    // rehash.  So if this group has one, no probe passes it, and the
+    // bucket can become empty rather than deleted.
+    std::size_t first = bucket & ~(Group::kWidth - 1);
+    if (Group(ctrl() + first).matchEmpty()) {
+      ctrl()[bucket] = kEmpty;
+      ++growthLeft_;
+    } else {
+      ctrl()[bucket] = kDeleted;
+    }
+  }
+
+  // Builds a fresh index, dropping deleted buckets.  Hashing keys that
+  // are already in the map does not throw.
+  void rehash(std::size_t buckets) {
+    char* index = ByteAlloc().allocate(indexBytes(buckets));
+    if (index_) {
+      ByteAlloc().deallocate(index_, indexBytes(bucketCount_));
+    }
+    index_ = index;
+    bucketCount_ = buckets;
+    growthLeft_ = maxLoad(buckets);
+    std::memset(ctrl(), kEmpty, buckets);
+    for (std::size_t i = 0; i < size_; ++i) {
+      claimBucket(Hash()(items_[i].first), i);
+    }
+  }
+
+  void growItems() {
+    if (itemCapacity_ > std::numeric_limits<uint32_t>::max() / 2) {
+      throw std::length_error("FlatHashMap too large");
+    }
+    std::size_t capacity = itemCapacity_ ? itemCapacity_ * 2 : 4;
+    value_type* items = ItemAlloc().allocate(capacity);
+    for (std::size_t i = 0; i < size_; ++i) {
+      relocate(items + i, items_ + i);
+    }
+    if (items_) {
+      ItemAlloc().deallocate(items_, itemCapacity_);
+    }
+    items_ = items;
+    itemCapacity_ = capacity;
+  }
+
+  // Moves *from to uninitialized memory at to and destroys *from.  The
+  // key is const only to keep users from changing it in place; moving
+  // out of it is fine since from is destroyed right after.
+  static void relocate(value_type* to, value_type* from) noexcept {
+    new (to) value_type(
+        std::move(const_cast<Key&>(from->first)), std::move(from->second));
+    from->~value_type();
+  }
+
+  void destroy() noexcept {
+    for (std::size_t i = 0; i < size_; ++i) {
+      items_[i].~value_type();
+    }
+    if (items_) {
+      ItemAlloc().deallocate(items_, itemCapacity_);
+    }
+    if (index_) {
+      ByteAlloc().deallocate(index_, indexBytes(bucketCount_));
+    }
+    items_ = nullptr;
+    index_ = nullptr;
+    size_ = itemCapacity_ = bucketCount_ = growthLeft_ = 0;
+  }
+
+  value_type* items_;
+  // bucketCount_ item positions, followed by as many control bytes.
+  char* index_;
+  uint32_t size_;
+  uint32_t itemCapacity_;
+  uint32_t bucketCount_;
+  uint32_t growthLeft_;
+};
+
+/*
+ * A hash for byte strings that takes 8 bytes at a time, for the keys of
+ * flat objects.  Much faster than fnv32_buf on all but the shortest
+ * strings, and it mixes all 64 bits, which FlatHashMap needs.  Not
+ * stable across releases; don't persist it.
+ */
+inline uint64_t flatHashBytes(void const* data, std::size_t size) {
+  auto p = static_cast<char const*>(data);
+  auto load64 = [](char const* at) {
+    uint64_t word;
+    std::memcpy(&word, at, sizeof(word));
+    return word;
+  };
+  auto load32 = [](char const* at) {
+    uint32_t word;
+    std::memcpy(&word, at, sizeof(word));
+    return uint64_t(word);
+  };
+
+  uint64_t seed = size * 0x9e3779b97f4a7c15ULL;
+  if (size <= 16) {
+    uint64_t a = 0;
+    uint64_t b = 0;
+    // Overlapping loads cover every length without a loop.
+    if (size >= 8) {
+      a = load64(p);
+      b = load64(p + size - 8);
+    } else if (size >= 4) {
+      a = load32(p);
+      b = load32(p + size - 4);
+    } else if (size > 0) {
+      a = (uint64_t(uint8_t(p[0])) << 16) |
+          (uint64_t(uint8_t(p[size / 2])) << 8) | uint8_t(p[size - 1]);
+    }
+    return hash::hash_128_to_64(seed ^ a, b);
+  }
+
+  uint64_t h = seed;
+  char const* end = p + size;
+  for (; end - p > 16; p += 16) {
+    h = hash::hash_128_to_64(h ^ load64(p), load64(p + 8));
+  }
+  return hash::hash_128_to_64(h ^ load64(end - 16), load64(end - 8));
+}
+
+}
+
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <folly/Bits.h>
+#include <folly/CpuId.h>
+#include <folly/Portability.h>
+#include <folly/detail/RangeCommon.h>
+
+#if FOLLY_X64
+#include <immintrin.h>
+#endif
+
+namespace folly {
+
+namespace detail {
+
+/***
+ *  The qfind_json_special_* functions return the offset of the first byte of
+ *  haystack that cannot be copied verbatim into or out of a JSON string
+ *  literal, or haystack.size() if there is no such byte.
+ *
+ *  Special bytes are the double quote, the backslash and the control
+ *  characters (<= 0x1f). If nonAscii is set, every byte with the high bit
+ *  set is special as well, which lets the serializer hand multi-byte UTF-8
+ *  sequences to its validating / encoding slow path.
+ */
+
+inline bool is_json_special(unsigned char c, bool nonAscii) {
+  return c == '\"' || c == '\\' || c <= 0x1f || (nonAscii && (c & 0x80));
+}
+
+// Portable fallback, scanning 8 bytes at a time using the "has zero byte"
+// bit tricks. A word with any special byte is re-examined bytewise, so the
+// false positives the tricks allow above the first hit are harmless.
+inline size_t qfind_json_special_nosimd(const StringPieceLite haystack,
+                                        bool nonAscii) {
+  constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr uint64_t kHighs = 0x8080808080808080ULL;
+  auto hasLess = [](uint64_t x, uint8_t n) {
+    return (x - kOnes * n) & ~x & kHighs;
+  };
+
+  const char* const b = haystack.begin();
+  const size_t n = haystack.size();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t w;
+    std::memcpy(&w, b + i, sizeof(w));
+    uint64_t hit = hasLess(w ^ (kOnes * '\"'), 1) |
+                   hasLess(w ^ (kOnes * '\\'), 1) |
+                   hasLess(w, 0x20);
+    if (nonAscii) {
+      hit |= w & kHighs;
+    }
+    if (hit) {
+      break;
+    }
+  }
+  for (; i < n; ++i) {
+    if (is_json_special(static_cast<unsigned char>(b[i]), nonAscii)) {
+      return i;
+    }
+  }
+  return n;
+}
+
+#if FOLLY_X64
+
+// SSE2 is part of the x86_64 baseline, so this needs no runtime check.
+inline size_t qfind_json_special_sse2(const StringPieceLite haystack,
+                                      bool nonAscii) {
+  const char* const b = haystack.begin();
+  const size_t n = haystack.size();
+  const __m128i quote = _mm_set1_epi8('\"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i maxControl = _mm_set1_epi8(0x1f);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    // max(v, 0x1f) == 0x1f iff v <= 0x1f as an unsigned byte
+    const __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(v, maxControl), maxControl));
+    uint32_t mask = _mm_movemask_epi8(special);
+    if (nonAscii) {
+      mask |= _mm_movemask_epi8(v);
+    }
+    if (mask) {
+      return i + findFirstSet(mask) - 1;
+    }
+  }
+  return i + qfind_json_special_nosimd(
+                 StringPieceLite(b + i, b + n), nonAscii);
+}
+
+FOLLY_TARGET_ATTRIBUTE("avx2")
+inline size_t qfind_json_special_avx2(const StringPieceLite haystack,
+                                      bool nonAscii) {
+  const char* const b = haystack.begin();
+  const size_t n = haystack.size();
+  const __m256i quote = _mm256_set1_epi8('\"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i maxControl = _mm256_set1_epi8(0x1f);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    const __m256i special = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+        _mm256_cmpeq_epi8(_mm256_max_epu8(v, maxControl), maxControl));
+    uint32_t mask = _mm256_movemask_epi8(special);
+    if (nonAscii) {
+      mask |= _mm256_movemask_epi8(v);
+    }
+    if (mask) {
+      return i + findFirstSet(mask) - 1;
+    }
+  }
+  return i + qfind_json_special_sse2(
+                 StringPieceLite(b + i, b + n), nonAscii);
+}
+
+// The AVX2 bit alone is not enough; the OS must also save the ymm state.
+// Kept out of line: CpuId's cpuid asm is not volatile, and once inlined the
+// compiler may hoist it out of the one-time initialization below into every
+// caller, where it is slow (and traps under virtualization).
+FOLLY_NOINLINE inline bool json_scan_can_use_avx2() {
+  folly::CpuId cpu;
+  if (!cpu.osxsave() || !cpu.avx() || !cpu.avx2()) {
+    return false;
+  }
+#ifdef _MSC_VER
+  const uint64_t xcr0 = _xgetbv(0);
+#else
+  uint32_t lo, hi;
+  __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  const uint64_t xcr0 = (uint64_t(hi) << 32) | lo;
+#endif
+  return (xcr0 & 0x6) == 0x6;
+}
+
+#endif
+
+inline size_t qfind_json_special(const StringPieceLite haystack,
+                                 bool nonAscii) {
+#if FOLLY_X64
+  static auto const qfind_json_special_fn =
+    json_scan_can_use_avx2() ? qfind_json_special_avx2
+                             : qfind_json_special_sse2;
+  return qfind_json_special_fn(haystack, nonAscii);
+#else
+  return qfind_json_special_nosimd(haystack, nonAscii);
+#endif
+}
+
+}
+
+}
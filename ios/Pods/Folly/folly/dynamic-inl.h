@@ -22,6 +22,9 @@
 #include <folly/Likely.h>
 #include <folly/Conv.h>
 #include <folly/Format.h>
+#if FOLLY_DYNAMIC_FLAT_OBJECTS
+#include <folly/detail/FlatHashMap.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////
 
@@ -125,7 +128,143 @@ namespace detail {
  * Note: Later we may add separate order tracking here (a multi-index
  * type of thing.)
  */
-struct dynamic::ObjectImpl : std::unordered_map<dynamic, dynamic> {};
+#if FOLLY_DYNAMIC_FLAT_OBJECTS
+
+namespace detail {
+
+// Same equivalence classes as dynamic::hash(), but every bit counts, and
+// strings hash faster.
+struct DynamicFlatHash {
+  uint64_t operator()(dynamic const& key) const {
+    if (key.isString()) {
+      auto& str = key.getString();
+      return flatHashBytes(str.data(), str.size());
+    }
+    return hash::twang_mix64(key.hash());
+  }
+};
+
+// Ints and doubles compare equal, but hash differently, so as keys they
+// are always different.
+struct DynamicFlatKeyEqual {
+  bool operator()(dynamic const& a, dynamic const& b) const {
+    return a.type() == b.type() && a == b;
+  }
+};
+
+}
+
+struct dynamic::ObjectImpl : detail::FlatHashMap<
+    dynamic,
+    dynamic,
+    detail::DynamicFlatHash,
+    detail::DynamicFlatKeyEqual,
+    detail::DynamicAllocator<std::pair<dynamic const, dynamic>>> {};
+
+#else
+
+struct dynamic::ObjectImpl : std::unordered_map<
+    dynamic,
+    dynamic,
+    std::hash<dynamic>,
+    std::equal_to<dynamic>,
+    detail::DynamicAllocator<std::pair<dynamic const, dynamic>>> {};
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
+template<class T> struct dynamic::GetAddrImpl {};
+template<> struct dynamic::GetAddrImpl<void*> {
+  static void** get(Data& d) noexcept { return &d.nul; }
+  static void* const* get(Data const& d) noexcept { return &d.nul; }
+};
+template<> struct dynamic::GetAddrImpl<bool> {
+  static bool* get(Data& d) noexcept { return &d.boolean; }
+  static bool const* get(Data const& d) noexcept { return &d.boolean; }
+};
+template<> struct dynamic::GetAddrImpl<int64_t> {
+  static int64_t* get(Data& d) noexcept { return &d.integer; }
+  static int64_t const* get(Data const& d) noexcept { return &d.integer; }
+};
+template<> struct dynamic::GetAddrImpl<double> {
+  static double* get(Data& d) noexcept { return &d.doubl; }
+  static double const* get(Data const& d) noexcept { return &d.doubl; }
+};
+template <>
+struct dynamic::GetAddrImpl<std::string> {
+  static std::string* get(Data& d) noexcept {
+    return &d.string;
+  }
+  static std::string const* get(Data const& d) noexcept {
+    return &d.string;
+  }
+};
+
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+
+template<> struct dynamic::GetAddrImpl<dynamic::Array> {
+  static Array* get(Data& d) { return &d.array.mutate(); }
+  static Array const* get(Data const& d) noexcept { return &d.array.get(); }
+};
+template<> struct dynamic::GetAddrImpl<dynamic::ObjectImpl> {
+  static ObjectImpl* get(Data& d) { return &d.object.mutate(); }
+  static ObjectImpl const* get(Data const& d) noexcept {
+    return &d.object.get();
+  }
+};
+
+template<class T> struct dynamic::StorageImpl {
+  typedef T type;
+  static T* get(Data& d) noexcept { return GetAddrImpl<T>::get(d); }
+};
+template<> struct dynamic::StorageImpl<dynamic::Array> {
+  typedef detail::DynamicCowPtr<Array> type;
+  static type* get(Data& d) noexcept { return &d.array; }
+};
+template<> struct dynamic::StorageImpl<dynamic::ObjectImpl> {
+  typedef detail::DynamicCowPtr<ObjectImpl> type;
+  static type* get(Data& d) noexcept { return &d.object; }
+};
+
+#else
+
+template<> struct dynamic::GetAddrImpl<dynamic::Array> {
+  static Array* get(Data& d) noexcept { return &d.array; }
+  static Array const* get(Data const& d) noexcept { return &d.array; }
+};
+template<> struct dynamic::GetAddrImpl<dynamic::ObjectImpl> {
+  static_assert(sizeof(ObjectImpl) <= sizeof(Data::objectBuffer),
+    "In your implementation, std::unordered_map<> apparently takes different"
+    " amount of space depending on its template parameters.  This is "
+    "weird.  Make objectBuffer bigger if you want to compile dynamic.");
+
+  static ObjectImpl* get(Data& d) noexcept {
+    void* data = &d.objectBuffer;
+    return static_cast<ObjectImpl*>(data);
+  }
+  static ObjectImpl const* get(Data const& d) noexcept {
+    void const* data = &d.objectBuffer;
+    return static_cast<ObjectImpl const*>(data);
+  }
+};
+
+template<class T> struct dynamic::StorageImpl {
+  typedef T type;
+  static T* get(Data& d) noexcept { return GetAddrImpl<T>::get(d); }
+};
+
+#endif
+
+template<class T>
+dynamic::Storage<T>* dynamic::getStorage() noexcept {
+  return StorageImpl<T>::get(u_);
+}
+
+template<class T>
+dynamic::Storage<T> const* dynamic::getStorage() const noexcept {
+  return const_cast<dynamic*>(this)->getStorage<T>();
+}
 
 //////////////////////////////////////////////////////////////////////
 
@@ -218,13 +357,13 @@ inline dynamic::dynamic(std::nullptr_t) : type_(NULLT) {}
 inline dynamic::dynamic(void (*)(EmptyArrayTag))
   : type_(ARRAY)
 {
-  new (&u_.array) Array();
+  new (getStorage<Array>()) Storage<Array>();
 }
 
 inline dynamic::dynamic(ObjectMaker (*)())
   : type_(OBJECT)
 {
-  new (getAddress<ObjectImpl>()) ObjectImpl();
+  new (getStorage<ObjectImpl>()) Storage<ObjectImpl>();
 }
 
 inline dynamic::dynamic(StringPiece s)
@@ -248,8 +387,8 @@ inline dynamic::dynamic(std::string s)
 inline dynamic::dynamic(ObjectMaker&& maker)
   : type_(OBJECT)
 {
-  new (getAddress<ObjectImpl>())
-    ObjectImpl(std::move(*maker.val_.getAddress<ObjectImpl>()));
+  new (getStorage<ObjectImpl>())
+    Storage<ObjectImpl>(std::move(*maker.val_.getStorage<ObjectImpl>()));
 }
 
 inline dynamic::dynamic(dynamic const& o)
@@ -295,7 +434,7 @@ template <class Iterator>
 dynamic::dynamic(Iterator first, Iterator last)
   : type_(ARRAY)
 {
-  new (&u_.array) Array(first, last);
+  new (getStorage<Array>()) Storage<Array>(Array(first, last));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -488,10 +627,12 @@ template<class K> inline dynamic& dynamic::setDefault(K&& k, const dynamic& v) {
 }
 
 inline dynamic* dynamic::get_ptr(dynamic const& idx) & {
+  unshare();
   return const_cast<dynamic*>(const_cast<dynamic const*>(this)->get_ptr(idx));
 }
 
 inline dynamic& dynamic::at(dynamic const& idx) & {
+  unshare();
   return const_cast<dynamic&>(const_cast<dynamic const*>(this)->at(idx));
 }
 
@@ -516,8 +657,15 @@ inline dynamic::const_item_iterator dynamic::find(dynamic const& key) const {
 
 template<class K, class V> inline void dynamic::insert(K&& key, V&& val) {
   auto& obj = get<ObjectImpl>();
+#if FOLLY_DYNAMIC_FLAT_OBJECTS
+  // val may refer into this object, which inserting the key can move.
+  dynamic value(std::forward<V>(val));
+  obj.insert({ std::forward<K>(key), nullptr }).first->second =
+    std::move(value);
+#else
   auto rv = obj.insert({ std::forward<K>(key), nullptr });
   rv.first->second = std::forward<V>(val);
+#endif
 }
 
 inline void dynamic::update(const dynamic& mergeObj) {
@@ -561,41 +709,67 @@ inline std::size_t dynamic::erase(dynamic const& key) {
 }
 
 inline dynamic::const_iterator dynamic::erase(const_iterator it) {
+  // The position has to be taken before get<Array>(), which may copy the
+  // array it points into.
+  auto pos = it - begin();
   auto& arr = get<Array>();
   // std::vector doesn't have an erase method that works on const iterators,
   // even though the standard says it should, so this hack converts to a
   // non-const iterator before calling erase.
-  return get<Array>().erase(arr.begin() + (it - arr.begin()));
+  return arr.erase(arr.begin() + pos);
 }
 
 inline dynamic::const_key_iterator dynamic::erase(const_key_iterator it) {
-  return const_key_iterator(get<ObjectImpl>().erase(it.base()));
+  return erase(it, std::next(it));
 }
 
 inline dynamic::const_key_iterator dynamic::erase(const_key_iterator first,
                                                   const_key_iterator last) {
-  return const_key_iterator(get<ObjectImpl>().erase(first.base(),
-                                                    last.base()));
+  return const_key_iterator(eraseItems(first.base(), last.base()).base());
 }
 
 inline dynamic::const_value_iterator dynamic::erase(const_value_iterator it) {
-  return const_value_iterator(get<ObjectImpl>().erase(it.base()));
+  return erase(it, std::next(it));
 }
 
 inline dynamic::const_value_iterator dynamic::erase(const_value_iterator first,
                                                     const_value_iterator last) {
-  return const_value_iterator(get<ObjectImpl>().erase(first.base(),
-                                                      last.base()));
+  return const_value_iterator(eraseItems(first.base(), last.base()).base());
 }
 
 inline dynamic::const_item_iterator dynamic::erase(const_item_iterator it) {
-  return const_item_iterator(get<ObjectImpl>().erase(it.base()));
+  return erase(it, std::next(it));
 }
 
 inline dynamic::const_item_iterator dynamic::erase(const_item_iterator first,
                                                    const_item_iterator last) {
-  return const_item_iterator(get<ObjectImpl>().erase(first.base(),
-                                                     last.base()));
+  return eraseItems(first, last);
+}
+
+inline dynamic::const_item_iterator dynamic::eraseItems(
+    const_item_iterator first,
+    const_item_iterator last) {
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+  // As for arrays, but positions in flat objects are offsets too.
+  auto begin = items().begin();
+  auto i = first - begin;
+  auto j = last - begin;
+  auto& obj = get<ObjectImpl>();
+  return obj.erase(obj.begin() + i, obj.begin() + j);
+#else
+  return const_item_iterator(
+    get<ObjectImpl>().erase(first.base(), last.base()));
+#endif
+}
+
+inline void dynamic::unshare() {
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+  if (type_ == ARRAY) {
+    getAddress<Array>();
+  } else if (type_ == OBJECT) {
+    getAddress<ObjectImpl>();
+  }
+#endif
 }
 
 inline void dynamic::resize(std::size_t sz, dynamic const& c) {
@@ -621,7 +795,7 @@ inline void dynamic::pop_back() {
 //////////////////////////////////////////////////////////////////////
 
 inline dynamic::dynamic(Array&& r) : type_(ARRAY) {
-  new (&u_.array) Array(std::move(r));
+  new (getStorage<Array>()) Storage<Array>(std::move(r));
 }
 
 #define FOLLY_DYNAMIC_DEC_TYPEINFO(T, str, val) \
@@ -656,7 +830,7 @@ T dynamic::asImpl() const {
 
 // Return a T* to our type, or null if we're not that type.
 template<class T>
-T* dynamic::get_nothrow() & noexcept {
+T* dynamic::get_nothrow() & noexcept(!FOLLY_DYNAMIC_COPY_ON_WRITE) {
   if (type_ != TypeInfo<T>::type) {
     return nullptr;
   }
@@ -665,55 +839,24 @@ T* dynamic::get_nothrow() & noexcept {
 
 template<class T>
 T const* dynamic::get_nothrow() const& noexcept {
-  return const_cast<dynamic*>(this)->get_nothrow<T>();
+  if (type_ != TypeInfo<T>::type) {
+    return nullptr;
+  }
+  return getAddress<T>();
 }
 
 // Return T* for where we can put a T, without type checking.  (Memory
 // might be uninitialized, even.)
 template<class T>
-T* dynamic::getAddress() noexcept {
+T* dynamic::getAddress() noexcept(!FOLLY_DYNAMIC_COPY_ON_WRITE) {
   return GetAddrImpl<T>::get(u_);
 }
 
 template<class T>
 T const* dynamic::getAddress() const noexcept {
-  return const_cast<dynamic*>(this)->getAddress<T>();
+  return GetAddrImpl<T>::get(u_);
 }
 
-template<class T> struct dynamic::GetAddrImpl {};
-template<> struct dynamic::GetAddrImpl<void*> {
-  static void** get(Data& d) noexcept { return &d.nul; }
-};
-template<> struct dynamic::GetAddrImpl<dynamic::Array> {
-  static Array* get(Data& d) noexcept { return &d.array; }
-};
-template<> struct dynamic::GetAddrImpl<bool> {
-  static bool* get(Data& d) noexcept { return &d.boolean; }
-};
-template<> struct dynamic::GetAddrImpl<int64_t> {
-  static int64_t* get(Data& d) noexcept { return &d.integer; }
-};
-template<> struct dynamic::GetAddrImpl<double> {
-  static double* get(Data& d) noexcept { return &d.doubl; }
-};
-template <>
-struct dynamic::GetAddrImpl<std::string> {
-  static std::string* get(Data& d) noexcept {
-    return &d.string;
-  }
-};
-template<> struct dynamic::GetAddrImpl<dynamic::ObjectImpl> {
-  static_assert(sizeof(ObjectImpl) <= sizeof(Data::objectBuffer),
-    "In your implementation, std::unordered_map<> apparently takes different"
-    " amount of space depending on its template parameters.  This is "
-    "weird.  Make objectBuffer bigger if you want to compile dynamic.");
-
-  static ObjectImpl* get(Data& d) noexcept {
-    void* data = &d.objectBuffer;
-    return static_cast<ObjectImpl*>(data);
-  }
-};
-
 template<class T>
 T& dynamic::get() {
   if (auto* p = get_nothrow<T>()) {
@@ -724,7 +867,10 @@ T& dynamic::get() {
 
 template<class T>
 T const& dynamic::get() const {
-  return const_cast<dynamic*>(this)->get<T>();
+  if (auto* p = get_nothrow<T>()) {
+    return *p;
+  }
+  throw TypeError(TypeInfo<T>::name, type());
 }
 
 //////////////////////////////////////////////////////////////////////
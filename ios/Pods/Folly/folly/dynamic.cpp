@@ -14,7 +14,13 @@
  * limitations under the License.
  */
 
+#include <folly/Arena.h>
+#include <folly/Bits.h>
+#include <folly/DynamicBinary.h>
 #include <folly/Hash.h>
+#include <folly/JsonPatch.h>
+#include <folly/JsonPath.h>
+#include <folly/Varint.h>
 #include <folly/dynamic.h>
 #include <folly/portability/BitsFunctexcept.h>
 
@@ -22,6 +28,22 @@ namespace folly {
 
 //////////////////////////////////////////////////////////////////////
 
+#if FOLLY_DYNAMIC_ARENA
+
+namespace detail {
+
+thread_local SysArena* dynamicArena = nullptr;
+
+void* dynamicArenaAllocate(std::size_t size) {
+  return dynamicArena->allocate(size);
+}
+
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
 #define FOLLY_DYNAMIC_DEF_TYPEINFO(T) \
   constexpr const char* dynamic::TypeInfo<T>::name; \
   constexpr dynamic::Type dynamic::TypeInfo<T>::type; \
@@ -113,6 +135,18 @@ bool dynamic::operator==(dynamic const& o) const {
     return false;
   }
 
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+  // Copies that still share their array or object are equal without
+  // looking inside, which makes comparing a document to an earlier copy
+  // of itself cheap.  Unlike an element by element comparison, this
+  // holds even when they contain a NaN (see dynamic.h).
+  if ((type_ == ARRAY && getAddress<Array>() == o.getAddress<Array>()) ||
+      (type_ == OBJECT &&
+       getAddress<ObjectImpl>() == o.getAddress<ObjectImpl>())) {
+    return true;
+  }
+#endif
+
 #define FB_X(T) return *getAddress<T>() == *o.getAddress<T>();
   FB_DYNAMIC_APPLY(type_, FB_X);
 #undef FB_X
@@ -121,12 +155,12 @@ bool dynamic::operator==(dynamic const& o) const {
 dynamic& dynamic::operator=(dynamic const& o) {
   if (&o != this) {
     if (type_ == o.type_) {
-#define FB_X(T) *getAddress<T>() = *o.getAddress<T>()
+#define FB_X(T) *getStorage<T>() = *o.getStorage<T>()
       FB_DYNAMIC_APPLY(type_, FB_X);
 #undef FB_X
     } else {
       destroy();
-#define FB_X(T) new (getAddress<T>()) T(*o.getAddress<T>())
+#define FB_X(T) new (getStorage<T>()) Storage<T>(*o.getStorage<T>())
       FB_DYNAMIC_APPLY(o.type_, FB_X);
 #undef FB_X
       type_ = o.type_;
@@ -138,12 +172,13 @@ dynamic& dynamic::operator=(dynamic const& o) {
 dynamic& dynamic::operator=(dynamic&& o) noexcept {
   if (&o != this) {
     if (type_ == o.type_) {
-#define FB_X(T) *getAddress<T>() = std::move(*o.getAddress<T>())
+#define FB_X(T) *getStorage<T>() = std::move(*o.getStorage<T>())
       FB_DYNAMIC_APPLY(type_, FB_X);
 #undef FB_X
     } else {
       destroy();
-#define FB_X(T) new (getAddress<T>()) T(std::move(*o.getAddress<T>()))
+#define FB_X(T) \
+  new (getStorage<T>()) Storage<T>(std::move(*o.getStorage<T>()))
       FB_DYNAMIC_APPLY(o.type_, FB_X);
 #undef FB_X
       type_ = o.type_;
@@ -254,10 +289,11 @@ std::size_t dynamic::size() const {
 
 dynamic::const_iterator
 dynamic::erase(const_iterator first, const_iterator last) {
+  // See erase(const_iterator).
+  auto pos = first - begin();
+  auto end = last - begin();
   auto& arr = get<Array>();
-  return get<Array>().erase(
-    arr.begin() + (first - arr.begin()),
-    arr.begin() + (last - arr.begin()));
+  return arr.erase(arr.begin() + pos, arr.begin() + end);
 }
 
 std::size_t dynamic::hash() const {
@@ -292,7 +328,7 @@ void dynamic::destroy() noexcept {
   // This short-circuit speeds up some microbenchmarks.
   if (type_ == NULLT) return;
 
-#define FB_X(T) detail::Destroy::destroy(getAddress<T>())
+#define FB_X(T) detail::Destroy::destroy(getStorage<T>())
   FB_DYNAMIC_APPLY(type_, FB_X);
 #undef FB_X
   type_ = NULLT;
@@ -301,4 +337,473 @@ void dynamic::destroy() noexcept {
 
 //////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// See DynamicBinary.h for the format.
+enum BinaryTag : uint8_t {
+  kBinaryNull = 0x00,
+  kBinaryFalse = 0x01,
+  kBinaryTrue = 0x02,
+  kBinaryInt = 0x03,
+  kBinaryDouble = 0x04,
+  kBinaryString = 0x05,
+  kBinaryArray = 0x06,
+  kBinaryObject = 0x07,
+  kBinarySmallInt = 0x80,
+};
+
+void appendTagged(std::string& out, BinaryTag tag, uint64_t value) {
+  uint8_t buf[1 + kMaxVarintLength64];
+  buf[0] = tag;
+  auto size = 1 + encodeVarint(value, buf + 1);
+  out.append(reinterpret_cast<char const*>(buf), size);
+}
+
+void encodeBinary(dynamic const& value, std::string& out) {
+  switch (value.type()) {
+  case dynamic::NULLT:
+    out.push_back(char(kBinaryNull));
+    break;
+  case dynamic::BOOL:
+    out.push_back(char(value.getBool() ? kBinaryTrue : kBinaryFalse));
+    break;
+  case dynamic::INT64: {
+    auto const i = value.getInt();
+    if (i >= 0 && i < 0x80) {
+      out.push_back(char(kBinarySmallInt | i));
+    } else {
+      appendTagged(out, kBinaryInt, encodeZigZag(i));
+    }
+    break;
+  }
+  case dynamic::DOUBLE: {
+    uint64_t bits;
+    auto const d = value.getDouble();
+    std::memcpy(&bits, &d, sizeof(bits));
+    bits = Endian::little(bits);
+    out.push_back(char(kBinaryDouble));
+    out.append(reinterpret_cast<char const*>(&bits), sizeof(bits));
+    break;
+  }
+  case dynamic::STRING: {
+    auto const& str = value.getString();
+    appendTagged(out, kBinaryString, str.size());
+    out.append(str);
+    break;
+  }
+  case dynamic::ARRAY:
+    appendTagged(out, kBinaryArray, value.size());
+    for (auto const& element : value) {
+      encodeBinary(element, out);
+    }
+    break;
+  case dynamic::OBJECT:
+    appendTagged(out, kBinaryObject, value.size());
+    for (auto const& item : value.items()) {
+      encodeBinary(item.first, out);
+      encodeBinary(item.second, out);
+    }
+    break;
+  default:
+    CHECK(0); abort();
+  }
+}
+
+struct BinaryDecoder {
+  ByteRange data;
+  unsigned recursionLimit;
+
+  dynamic decode(unsigned depth) {
+    auto const tag = byte();
+    if (tag & kBinarySmallInt) {
+      return int64_t(tag & ~kBinarySmallInt);
+    }
+    switch (tag) {
+    case kBinaryNull:
+      return nullptr;
+    case kBinaryFalse:
+      return false;
+    case kBinaryTrue:
+      return true;
+    case kBinaryInt:
+      return decodeZigZag(varint());
+    case kBinaryDouble: {
+      uint64_t bits;
+      need(sizeof(bits));
+      std::memcpy(&bits, data.data(), sizeof(bits));
+      data.advance(sizeof(bits));
+      bits = Endian::little(bits);
+      double d;
+      std::memcpy(&d, &bits, sizeof(d));
+      return d;
+    }
+    case kBinaryString: {
+      auto const size = varint();
+      need(size);
+      auto const str = reinterpret_cast<char const*>(data.data());
+      data.advance(size);
+      return StringPiece(str, size);
+    }
+    case kBinaryArray: {
+      // Every element takes at least one byte, which bounds the size
+      // allocated up front.
+      auto const size = varint();
+      need(size);
+      enter(depth);
+      dynamic ret = dynamic::array;
+      ret.resize(size);
+      for (uint64_t i = 0; i < size; ++i) {
+        ret[i] = decode(depth + 1);
+      }
+      return ret;
+    }
+    case kBinaryObject: {
+      auto const size = varint();
+      need(size);
+      enter(depth);
+      dynamic ret = dynamic::object;
+      for (uint64_t i = 0; i < size; ++i) {
+        auto key = decode(depth + 1);
+        if (key.isNull() || key.isArray() || key.isObject()) {
+          throw BinaryParseError(
+              to<std::string>("invalid object key type ", key.typeName()));
+        }
+        ret.insert(std::move(key), decode(depth + 1));
+      }
+      return ret;
+    }
+    default:
+      throw BinaryParseError(to<std::string>("unknown tag ", unsigned(tag)));
+    }
+  }
+
+  void need(uint64_t size) const {
+    if (size > data.size()) {
+      throw BinaryParseError("unexpected end of input");
+    }
+  }
+
+  void enter(unsigned depth) const {
+    if (depth >= recursionLimit) {
+      throw BinaryParseError("recursion limit exceeded");
+    }
+  }
+
+  uint8_t byte() {
+    need(1);
+    auto const b = data.front();
+    data.pop_front();
+    return b;
+  }
+
+  // Not decodeVarint(), which shifts a signed value out of range when
+  // the tenth byte is above 0x01.
+  uint64_t varint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      auto const b = byte();
+      if (shift == 63 && b > 0x01) {
+        throw BinaryParseError("varint too big");
+      }
+      value |= uint64_t(b & 0x7f) << shift;
+      if (!(b & 0x80)) {
+        return value;
+      }
+    }
+  }
+};
+
+}
+
+void toBinary(dynamic const& value, std::string& out) {
+  encodeBinary(value, out);
+}
+
+std::string toBinary(dynamic const& value) {
+  std::string out;
+  encodeBinary(value, out);
+  return out;
+}
+
+dynamic parseBinary(ByteRange data, unsigned recursionLimit) {
+  BinaryDecoder decoder{data, recursionLimit};
+  auto ret = decoder.decode(0);
+  if (!decoder.data.empty()) {
+    throw BinaryParseError("trailing bytes after value");
+  }
+  return ret;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class JsonDiffer {
+ public:
+  dynamic patch = dynamic::array;
+
+  void diff(dynamic const& from, dynamic const& to) {
+    // Values a copy-on-write copy still shares with its original are at
+    // the same address.
+    if (&from == &to) {
+      return;
+    }
+    if (from.isObject() && to.isObject()) {
+      diffObjects(from, to);
+    } else if (from.isArray() && to.isArray()) {
+      diffArrays(from, to);
+    } else if (from != to) {
+      addOp("replace", &to);
+    }
+  }
+
+ private:
+  void diffObjects(dynamic const& from, dynamic const& to) {
+    for (auto const& item : from.items()) {
+      auto mark = pushKey(item.first);
+      if (auto* value = to.get_ptr(item.first)) {
+        diff(item.second, *value);
+      } else {
+        addOp("remove", nullptr);
+      }
+      path_.resize(mark);
+    }
+    for (auto const& item : to.items()) {
+      if (!from.count(item.first)) {
+        auto mark = pushKey(item.first);
+        addOp("add", &item.second);
+        path_.resize(mark);
+      }
+    }
+  }
+
+  void diffArrays(dynamic const& from, dynamic const& to) {
+    auto f = from.begin();
+    auto t = to.begin();
+    std::size_t m = from.size();
+    std::size_t n = to.size();
+    std::size_t prefix = 0;
+    while (prefix < m && prefix < n && f[prefix] == t[prefix]) {
+      ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < m - prefix && suffix < n - prefix &&
+           f[m - 1 - suffix] == t[n - 1 - suffix]) {
+      ++suffix;
+    }
+    m -= suffix;
+    n -= suffix;
+
+    std::size_t i = prefix;
+    for (; i < m && i < n; ++i) {
+      auto mark = pushIndex(i);
+      diff(f[i], t[i]);
+      path_.resize(mark);
+    }
+    // Remove from the back, so that no removal moves the next one.
+    for (std::size_t j = m; j-- > i;) {
+      auto mark = pushIndex(j);
+      addOp("remove", nullptr);
+      path_.resize(mark);
+    }
+    for (; i < n; ++i) {
+      auto mark = pushIndex(i);
+      addOp("add", &t[i]);
+      path_.resize(mark);
+    }
+  }
+
+  std::size_t pushKey(dynamic const& key) {
+    auto mark = path_.size();
+    path_ += '/';
+    for (char c : key.getString()) {
+      if (c == '~') {
+        path_ += "~0";
+      } else if (c == '/') {
+        path_ += "~1";
+      } else {
+        path_ += c;
+      }
+    }
+    return mark;
+  }
+
+  std::size_t pushIndex(std::size_t index) {
+    auto mark = path_.size();
+    path_ += '/';
+    toAppend(index, &path_);
+    return mark;
+  }
+
+  void addOp(char const* op, dynamic const* value) {
+    dynamic entry = dynamic::object("op", op)("path", path_);
+    if (value) {
+      entry.insert("value", *value);
+    }
+    patch.push_back(std::move(entry));
+  }
+
+  std::string path_;
+};
+
+[[noreturn]] void throwPatchError(StringPiece what, StringPiece path) {
+  throw JsonPatchError(to<std::string>(what, " at '", path, "'"));
+}
+
+dynamic const& patchMember(dynamic const& op, char const* name) {
+  auto* member = op.get_ptr(name);
+  if (!member) {
+    throw JsonPatchError(to<std::string>("operation without \"", name, "\""));
+  }
+  return *member;
+}
+
+StringPiece patchPath(dynamic const& op, char const* name) {
+  auto const& member = patchMember(op, name);
+  if (!member.isString()) {
+    throw JsonPatchError(to<std::string>("\"", name, "\" is not a string"));
+  }
+  return member.getString();
+}
+
+dynamic* patchChild(dynamic& node, JsonPath::Token const& token) {
+  if (node.isObject()) {
+    return node.get_ptr(token.key);
+  }
+  if (node.isArray() && token.hasIndex && token.index < node.size()) {
+    return &node.at(token.index);
+  }
+  return nullptr;
+}
+
+// The container the last token of path is a member or element of.
+dynamic& patchParent(dynamic& doc, JsonPath const& path, StringPiece text) {
+  auto const& tokens = path.tokens();
+  dynamic* node = &doc;
+  for (std::size_t i = 0; i + 1 < tokens.size(); ++i) {
+    node = patchChild(*node, tokens[i]);
+    if (!node) {
+      throwPatchError("no such value", text);
+    }
+  }
+  if (!node->isObject() && !node->isArray()) {
+    throwPatchError("not in an array or object", text);
+  }
+  return *node;
+}
+
+// Const and non-const, so that reading a value does not unshare the
+// containers on the way to it.
+template <class D>
+D& patchTarget(D& doc, StringPiece text) {
+  auto* target = JsonPath::fromPointer(text).get_ptr(doc);
+  if (!target) {
+    throwPatchError("no such value", text);
+  }
+  return *target;
+}
+
+// Only moves from value once nothing can fail, so a value that could not
+// be added is still there to put back.
+void patchAdd(dynamic& doc, StringPiece text, dynamic&& value) {
+  auto path = JsonPath::fromPointer(text);
+  if (path.empty()) {
+    doc = std::move(value);
+    return;
+  }
+  auto& parent = patchParent(doc, path, text);
+  auto const& last = path.tokens().back();
+  if (parent.isObject()) {
+    parent[last.key] = std::move(value);
+  } else if (last.key == "-") {
+    parent.push_back(std::move(value));
+  } else if (last.hasIndex && last.index <= parent.size()) {
+    parent.push_back(nullptr);
+    for (std::size_t i = parent.size() - 1; i > last.index; --i) {
+      parent.at(i) = std::move(parent.at(i - 1));
+    }
+    parent.at(last.index) = std::move(value);
+  } else {
+    throwPatchError("array index out of range", text);
+  }
+}
+
+dynamic patchRemove(dynamic& doc, StringPiece text) {
+  auto path = JsonPath::fromPointer(text);
+  if (path.empty()) {
+    throwPatchError("cannot remove the whole document", text);
+  }
+  auto& parent = patchParent(doc, path, text);
+  auto* target = patchChild(parent, path.tokens().back());
+  if (!target) {
+    throwPatchError("no such value", text);
+  }
+  dynamic removed = std::move(*target);
+  if (parent.isObject()) {
+    parent.erase(path.tokens().back().key);
+  } else {
+    parent.erase(parent.begin() + path.tokens().back().index);
+  }
+  return removed;
+}
+
+}
+
+dynamic jsonDiff(dynamic const& from, dynamic const& to) {
+  JsonDiffer differ;
+  differ.diff(from, to);
+  return std::move(differ.patch);
+}
+
+void applyJsonPatch(dynamic& doc, dynamic const& patch) {
+  if (!patch.isArray()) {
+    throw JsonPatchError("a patch is an array of operations");
+  }
+  for (auto const& op : patch) {
+    if (!op.isObject()) {
+      throw JsonPatchError("an operation is an object");
+    }
+    auto const& name = patchMember(op, "op");
+    auto path = patchPath(op, "path");
+    if (name == "add") {
+      patchAdd(doc, path, dynamic(patchMember(op, "value")));
+    } else if (name == "remove") {
+      patchRemove(doc, path);
+    } else if (name == "replace") {
+      patchTarget(doc, path) = patchMember(op, "value");
+    } else if (name == "move") {
+      auto from = patchPath(op, "from");
+      if (from == path) {
+        continue;
+      }
+      if (path.startsWith(from) && path[from.size()] == '/') {
+        throwPatchError("cannot move a value into itself", path);
+      }
+      auto value = patchRemove(doc, from);
+      try {
+        patchAdd(doc, path, std::move(value));
+      } catch (...) {
+        // Where it came from is still there, since only the value itself
+        // was removed, so this leaves doc as it was before the move.
+        patchAdd(doc, from, std::move(value));
+        throw;
+      }
+    } else if (name == "copy") {
+      auto const& source = patchTarget(
+          static_cast<dynamic const&>(doc), patchPath(op, "from"));
+      patchAdd(doc, path, dynamic(source));
+    } else if (name == "test") {
+      if (patchTarget(static_cast<dynamic const&>(doc), path) !=
+          patchMember(op, "value")) {
+        throwPatchError("test failed", path);
+      }
+    } else {
+      throw JsonPatchError(
+          to<std::string>("unknown operation ", name.asString()));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
 }
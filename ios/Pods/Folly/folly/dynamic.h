@@ -47,11 +47,43 @@
  *
  * Additional documentation is in folly/docs/Dynamic.md.
  *
+ * Objects are std::unordered_maps.  Building with
+ * -DFOLLY_DYNAMIC_FLAT_OBJECTS=1 makes them flat, open addressing hash
+ * maps instead (see folly/detail/FlatHashMap.h).  These allocate twice
+ * per object rather than once per key, or just once for objects of up to
+ * 8 keys, which are searched without hashing.  They are faster to build,
+ * copy, search and walk, and iterate in insertion order until something
+ * is erased.
+ * In exchange, adding a key to an object invalidates references into
+ * it, as it would for an array.  All code linked together must agree on
+ * the setting.
+ *
+ * Copying a dynamic deep-copies its arrays and objects.  Building with
+ * -DFOLLY_DYNAMIC_COPY_ON_WRITE=1 (which needs flat objects, too) makes
+ * copies share them instead, each array and object being copied only
+ * when first changed through a copy that shares it; copying a large
+ * document and then changing a few values in it only copies the arrays
+ * and objects on the way to those values.  Copies may be used from
+ * different threads just as deep copies could.  As with Qt's implicitly
+ * shared containers, there is a catch: references and iterators into a
+ * dynamic are invalidated by copying it, if they were obtained from it
+ * through non-const access, and by non-const access to it after it was
+ * copied.  Copies that still share an array or object compare equal
+ * without looking inside, so one holding a NaN equals its copy, which it
+ * does not in other builds.
+ *
+ * Building with -DFOLLY_DYNAMIC_ARENA=1 adds parseJson() overloads that
+ * allocate the arrays and objects of the result from a SysArena (see
+ * json.h).  Every array and object allocation then checks a thread
+ * local for an active arena, which is why it is not on by default.  As
+ * with the other settings, all code linked together must agree on it.
+ *
  * @author Jordan DeLong <delong.j@fb.com>
  */
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <ostream>
@@ -63,15 +95,224 @@
 
 #include <boost/operators.hpp>
 
+#include <folly/Likely.h>
 #include <folly/Range.h>
 #include <folly/Traits.h>
 
+#ifndef FOLLY_DYNAMIC_FLAT_OBJECTS
+#define FOLLY_DYNAMIC_FLAT_OBJECTS 0
+#endif
+
+#ifndef FOLLY_DYNAMIC_COPY_ON_WRITE
+#define FOLLY_DYNAMIC_COPY_ON_WRITE 0
+#endif
+
+#ifndef FOLLY_DYNAMIC_ARENA
+#define FOLLY_DYNAMIC_ARENA 0
+#endif
+
+#if FOLLY_DYNAMIC_COPY_ON_WRITE && !FOLLY_DYNAMIC_FLAT_OBJECTS
+#error FOLLY_DYNAMIC_COPY_ON_WRITE requires FOLLY_DYNAMIC_FLAT_OBJECTS
+#endif
+
 namespace folly {
 
 //////////////////////////////////////////////////////////////////////
 
 struct dynamic;
 struct TypeError;
+class JsonPath;
+class SysArena;
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+#if FOLLY_DYNAMIC_ARENA
+
+/*
+ * The arena that arrays and objects created on this thread are
+ * allocated from, or null for the heap.  Only ever set through
+ * DynamicArenaScope; see parseJson(StringPiece, SysArena&) in json.h.
+ */
+extern thread_local SysArena* dynamicArena;
+
+void* dynamicArenaAllocate(std::size_t size);
+
+/*
+ * Allocator for the arrays and objects inside a dynamic.  This is
+ * std::allocator, except while a DynamicArenaScope is active: then
+ * memory comes from its arena and deallocation is a no-op, since the
+ * arena releases everything at once.  Being stateless, it doesn't make
+ * dynamic any bigger.
+ */
+template <class T>
+struct DynamicAllocator : std::allocator<T> {
+  template <class U> struct rebind {
+    typedef DynamicAllocator<U> other;
+  };
+
+  DynamicAllocator() noexcept {}
+  template <class U>
+  /* implicit */ DynamicAllocator(DynamicAllocator<U> const&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    if (LIKELY(!dynamicArena)) {
+      return std::allocator<T>::allocate(n);
+    }
+    return static_cast<T*>(dynamicArenaAllocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (LIKELY(!dynamicArena)) {
+      std::allocator<T>::deallocate(p, n);
+    }
+  }
+};
+
+inline bool usingDynamicArena() {
+  return dynamicArena != nullptr;
+}
+
+/*
+ * Routes all dynamic array and object allocations on the current thread
+ * to arena for as long as it lives.  Everything allocated under a scope
+ * must also be destroyed under one.
+ */
+class DynamicArenaScope {
+ public:
+  explicit DynamicArenaScope(SysArena& arena) : previous_(dynamicArena) {
+    dynamicArena = &arena;
+  }
+  ~DynamicArenaScope() {
+    dynamicArena = previous_;
+  }
+
+  DynamicArenaScope(DynamicArenaScope const&) = delete;
+  DynamicArenaScope& operator=(DynamicArenaScope const&) = delete;
+
+ private:
+  SysArena* previous_;
+};
+
+#else
+
+template <class T>
+using DynamicAllocator = std::allocator<T>;
+
+inline bool usingDynamicArena() {
+  return false;
+}
+
+#endif
+
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+
+/*
+ * What a dynamic built with FOLLY_DYNAMIC_COPY_ON_WRITE stores for an
+ * array or object: a handle to a reference counted value, which copies
+ * of the handle share until one of them asks for mutable access.  A null
+ * handle stands for an empty value, so that moving from one needs no
+ * allocation.
+ *
+ * Values allocated from an arena are never shared, as copies may outlive
+ * the arena.
+ */
+template <class T>
+class DynamicCowPtr {
+ public:
+  DynamicCowPtr() noexcept : box_(nullptr) {}
+  explicit DynamicCowPtr(T&& value) : box_(makeBox(std::move(value))) {}
+
+  DynamicCowPtr(DynamicCowPtr const& other) : box_(other.box_) {
+    if (!box_) {
+      return;
+    }
+    if (box_->shareable) {
+      box_->refs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      box_ = makeBox(other.box_->value);
+    }
+  }
+
+  DynamicCowPtr(DynamicCowPtr&& other) noexcept : box_(other.box_) {
+    other.box_ = nullptr;
+  }
+
+  DynamicCowPtr& operator=(DynamicCowPtr const& other) {
+    DynamicCowPtr copy(other);
+    std::swap(box_, copy.box_);
+    return *this;
+  }
+
+  DynamicCowPtr& operator=(DynamicCowPtr&& other) noexcept {
+    DynamicCowPtr moved(std::move(other));
+    std::swap(box_, moved.box_);
+    return *this;
+  }
+
+  ~DynamicCowPtr() {
+    release(box_);
+  }
+
+  T const& get() const noexcept {
+    return box_ ? box_->value : empty();
+  }
+
+  // Copies the value first if it is shared.
+  T& mutate() {
+    if (!box_) {
+      box_ = makeBox();
+    } else if (box_->refs.load(std::memory_order_acquire) != 1) {
+      Box* copy = makeBox(static_cast<T const&>(box_->value));
+      release(box_);
+      box_ = copy;
+    }
+    return box_->value;
+  }
+
+ private:
+  struct Box {
+    template <class... Args>
+    explicit Box(bool shareable_, Args&&... args)
+        : refs(1), shareable(shareable_), value(std::forward<Args>(args)...) {}
+
+    std::atomic<std::size_t> refs;
+    bool const shareable;
+    T value;
+  };
+
+  template <class... Args>
+  static Box* makeBox(Args&&... args) {
+    DynamicAllocator<Box> alloc;
+    Box* box = alloc.allocate(1);
+    try {
+      new (box) Box(!usingDynamicArena(), std::forward<Args>(args)...);
+    } catch (...) {
+      alloc.deallocate(box, 1);
+      throw;
+    }
+    return box;
+  }
+
+  static void release(Box* box) noexcept {
+    if (box && box->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      box->~Box();
+      DynamicAllocator<Box>().deallocate(box, 1);
+    }
+  }
+
+  static T const& empty() noexcept {
+    static T const value{};
+    return value;
+  }
+
+  Box* box_;
+};
+
+#endif
+
+}
 
 //////////////////////////////////////////////////////////////////////
 
@@ -97,7 +338,7 @@ struct dynamic : private boost::operators<dynamic> {
    * Object item iterators dereference as pairs of (key, value).
    */
 private:
-  typedef std::vector<dynamic> Array;
+  typedef std::vector<dynamic, detail::DynamicAllocator<dynamic>> Array;
 public:
   typedef Array::const_iterator const_iterator;
   typedef dynamic value_type;
@@ -515,22 +756,41 @@ public:
 
 private:
   friend struct TypeError;
+  friend class JsonPath;
   struct ObjectImpl;
   template<class T> struct TypeInfo;
   template<class T> struct CompareOp;
   template<class T> struct GetAddrImpl;
+  template<class T> struct StorageImpl;
   template<class T> struct PrintImpl;
 
   explicit dynamic(Array&& array);
 
   template<class T> T const& get() const;
   template<class T> T&       get();
-  template<class T> T*       get_nothrow() & noexcept;
+  // Mutable access to a shared array or object copies it, which may
+  // throw.
+  template<class T> T*       get_nothrow() &
+    noexcept(!FOLLY_DYNAMIC_COPY_ON_WRITE);
   template<class T> T const* get_nothrow() const& noexcept;
   template<class T> T*       get_nothrow() && noexcept = delete;
-  template<class T> T*       getAddress() noexcept;
+  template<class T> T*       getAddress()
+    noexcept(!FOLLY_DYNAMIC_COPY_ON_WRITE);
   template<class T> T const* getAddress() const noexcept;
 
+  // What the union holds for a T: the T itself, except for arrays and
+  // objects in copy-on-write builds.  Construction, assignment and
+  // destruction go through these rather than getAddress().
+  template<class T> using Storage = typename StorageImpl<T>::type;
+  template<class T> Storage<T>*       getStorage() noexcept;
+  template<class T> Storage<T> const* getStorage() const noexcept;
+
+  // In copy-on-write builds, makes sure this dynamic's array or object
+  // is not shared before references into it are handed out.
+  void unshare();
+  const_item_iterator eraseItems(const_item_iterator first,
+                                 const_item_iterator last);
+
   template<class T> T asImpl() const;
 
   static char const* typeName(Type);
@@ -547,12 +807,17 @@ private:
     // XXX: gcc does an ICE if we use std::nullptr_t instead of void*
     // here.  See http://gcc.gnu.org/bugzilla/show_bug.cgi?id=50361
     void* nul;
-    Array array;
     bool boolean;
     double doubl;
     int64_t integer;
     std::string string;
 
+#if FOLLY_DYNAMIC_COPY_ON_WRITE
+    detail::DynamicCowPtr<Array> array;
+    detail::DynamicCowPtr<ObjectImpl> object;
+#else
+    Array array;
+
     /*
      * Objects are placement new'd here.  We have to use a char buffer
      * because we don't know the type here (std::unordered_map<> with
@@ -564,6 +829,7 @@ private:
       sizeof(std::unordered_map<int,int>),
       alignof(std::unordered_map<int,int>)
     >::type objectBuffer;
+#endif
   } u_;
 };
 
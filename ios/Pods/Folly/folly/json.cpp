@@ -15,16 +15,31 @@
  */
 
 #include <folly/json.h>
+#include <folly/JsonPath.h>
+#include <folly/JsonView.h>
+#include <folly/LazyJson.h>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <boost/next_prior.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <folly/Arena.h>
 #include <folly/Conv.h>
+#include <folly/Exception.h>
+#include <folly/Executor.h>
+#include <folly/Hash.h>
 #include <folly/Portability.h>
 #include <folly/Range.h>
 #include <folly/String.h>
 #include <folly/Unicode.h>
+#include <folly/detail/JsonScan.h>
 #include <folly/portability/Constexpr.h>
+#include <folly/portability/Unistd.h>
 
 namespace folly {
 
@@ -117,12 +132,34 @@ char32_t decodeUtf8(
   throw std::runtime_error("folly::decodeUtf8 encoding length maxed out");
 }
 
+// Sort the items of an object the way sort_keys orders them, by
+// pointer, so that no key or value has to be copied.
+void sortItems(
+    dynamic const& o,
+    std::vector<SortedKeysCache::Item const*>& items) {
+  items.clear();
+  items.reserve(o.size());
+  for (auto& item : o.items()) {
+    items.push_back(&item);
+  }
+  std::sort(
+      items.begin(),
+      items.end(),
+      [] (SortedKeysCache::Item const* a, SortedKeysCache::Item const* b) {
+        return *a < *b;
+      });
+}
+
 struct Printer {
+  // How much output is buffered before it is passed on to the sink.
+  static constexpr size_t kSinkBufferSize = 16 * 1024;
+
   explicit Printer(
       std::string& out,
       unsigned* indentLevel,
-      serialization_opts const* opts)
-      : out_(out), indentLevel_(indentLevel), opts_(*opts) {}
+      serialization_opts const* opts,
+      Sink* sink = nullptr)
+      : out_(out), indentLevel_(indentLevel), opts_(*opts), sink_(sink) {}
 
   void operator()(dynamic const& v) const {
     switch (v.type()) {
@@ -164,25 +201,72 @@ struct Printer {
     }
   }
 
+  // The pieces printArray() and printObject() are made of, used directly
+  // by serializeParallel().
+  void openContainer(char bracket) const {
+    out_ += bracket;
+    indent();
+    newline();
+  }
+
+  void closeContainer(char bracket) const {
+    outdent();
+    newline();
+    out_ += bracket;
+  }
+
+  // Print a run of array elements or object items (or pointers to
+  // them), separating each from the one before unless it is the first
+  // in its container.
+  template <typename Iterator>
+  void printElements(Iterator begin, Iterator end, bool first) const {
+    for (; begin != end; ++begin) {
+      if (!first) {
+        out_ += ',';
+        newline();
+      }
+      first = false;
+      printElement(*begin);
+      flushIfFull();
+    }
+  }
+
+  void append(StringPiece s) const {
+    out_.append(s.data(), s.size());
+    flushIfFull();
+  }
+
+  // Without a sink, all output just accumulates in out_.
+  void flush() const {
+    if (sink_ && !out_.empty()) {
+      sink_->write(out_);
+      out_.clear();
+    }
+  }
+
 private:
-  void printKV(const std::pair<const dynamic, dynamic>& p) const {
-    if (!opts_.allow_non_string_keys && !p.first.isString()) {
+  void printElement(dynamic const& v) const {
+    (*this)(v);
+  }
+
+  template <typename K, typename V>
+  void printElement(std::pair<K, V> const& p) const {
+    printKV(p.first, p.second);
+  }
+
+  template <typename T>
+  void printElement(T const* p) const {
+    printElement(*p);
+  }
+
+  void printKV(dynamic const& key, dynamic const& value) const {
+    if (!opts_.allow_non_string_keys && !key.isString()) {
       throw std::runtime_error("folly::toJson: JSON object key was not a "
         "string");
     }
-    (*this)(p.first);
+    (*this)(key);
     mapColon();
-    (*this)(p.second);
-  }
-
-  template <typename Iterator>
-  void printKVPairs(Iterator begin, Iterator end) const {
-    printKV(*begin);
-    for (++begin; begin != end; ++begin) {
-      out_ += ',';
-      newline();
-      printKV(*begin);
-    }
+    (*this)(value);
   }
 
   void printObject(dynamic const& o) const {
@@ -191,20 +275,19 @@ private:
       return;
     }
 
-    out_ += '{';
-    indent();
-    newline();
+    openContainer('{');
     if (opts_.sort_keys) {
-      std::vector<std::pair<dynamic, dynamic>> items(
-        o.items().begin(), o.items().end());
-      std::sort(items.begin(), items.end());
-      printKVPairs(items.begin(), items.end());
+      std::vector<SortedKeysCache::Item const*> items;
+      if (opts_.sorted_keys_cache) {
+        opts_.sorted_keys_cache->sortedItems(o, items);
+      } else {
+        sortItems(o, items);
+      }
+      printElements(items.begin(), items.end(), true);
     } else {
-      printKVPairs(o.items().begin(), o.items().end());
+      printElements(o.items().begin(), o.items().end(), true);
     }
-    outdent();
-    newline();
-    out_ += '}';
+    closeContainer('}');
   }
 
   void printArray(dynamic const& a) const {
@@ -213,18 +296,9 @@ private:
       return;
     }
 
-    out_ += '[';
-    indent();
-    newline();
-    (*this)(a[0]);
-    for (auto& val : range(boost::next(a.begin()), a.end())) {
-      out_ += ',';
-      newline();
-      (*this)(val);
-    }
-    outdent();
-    newline();
-    out_ += ']';
+    openContainer('[');
+    printElements(a.begin(), a.end(), true);
+    closeContainer(']');
   }
 
 private:
@@ -250,12 +324,177 @@ private:
     out_ += indentLevel_ ? " : " : ":";
   }
 
+  void flushIfFull() const {
+    if (out_.size() >= kSinkBufferSize) {
+      flush();
+    }
+  }
+
 private:
  std::string& out_;
  unsigned* const indentLevel_;
  serialization_opts const& opts_;
+ Sink* const sink_;
+};
+
+// Chunks of the elements of one container, printed by whichever thread
+// claims them first.  Executor tasks share ownership of this, since the
+// ones that start after every chunk has been claimed may run after
+// serializeParallel() has returned; those touch nothing else.
+template <typename Element>
+struct ParallelChunks {
+  ParallelChunks(
+      std::vector<Element> elems,
+      serialization_opts const& o)
+      : elements(std::move(elems))
+      , opts(withoutCache(o))
+      , chunkSize(std::max<size_t>(o.parallel_chunk_size, 1))
+      , numChunks((elements.size() + chunkSize - 1) / chunkSize)
+      , outputs(numChunks)
+      , errors(numChunks)
+      , finished(numChunks)
+  {}
+
+  void work() {
+    for (size_t i; (i = next.fetch_add(1)) < numChunks; ) {
+      print(i);
+    }
+  }
+
+  // Wait for chunk i, printing unclaimed chunks in the meantime.
+  void await(size_t i) {
+    for (size_t j; (j = next.fetch_add(1)) < numChunks; ) {
+      print(j);
+      if (j >= i) {
+        break;
+      }
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    chunkDone.wait(lock, [&] { return finished[i]; });
+  }
+
+  // Stop handing out chunks, and wait for those already claimed.
+  void cancel() {
+    auto const claimed = std::min(next.exchange(numChunks), numChunks);
+    std::unique_lock<std::mutex> lock(mutex);
+    chunkDone.wait(lock, [&] { return done == claimed; });
+  }
+
+  std::vector<Element> const elements;
+  // A copy, since the chunks cannot share the (single-threaded) cache.
+  serialization_opts const opts;
+  size_t const chunkSize;
+  size_t const numChunks;
+  std::vector<std::string> outputs;
+  std::vector<std::exception_ptr> errors;
+
+ private:
+  static serialization_opts withoutCache(serialization_opts opts) {
+    opts.sorted_keys_cache = nullptr;
+    return opts;
+  }
+
+  void print(size_t i) {
+    // Chunks print at the nesting level of the container's elements.
+    unsigned indentLevel = 1;
+    Printer p(
+        outputs[i], opts.pretty_formatting ? &indentLevel : nullptr, &opts);
+    auto begin = elements.begin() + i * chunkSize;
+    auto end =
+        elements.begin() + std::min(elements.size(), (i + 1) * chunkSize);
+    try {
+      p.printElements(begin, end, i == 0);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    finished[i] = true;
+    ++done;
+    chunkDone.notify_one();
+  }
+
+  std::atomic<size_t> next{0};
+  std::mutex mutex;
+  // Only the calling thread waits on this.
+  std::condition_variable chunkDone;
+  std::vector<bool> finished;
+  size_t done{0};
 };
 
+template <typename Element>
+void printChunks(
+    Printer const& p,
+    std::vector<Element> elements,
+    serialization_opts const& opts) {
+  auto chunks = std::make_shared<ParallelChunks<Element>>(
+      std::move(elements), opts);
+  for (size_t i = 1; i < chunks->numChunks; ++i) {
+    // If the executor refuses a task, whatever it throws, this thread
+    // prints the chunks left over.  Nothing may escape before cancel():
+    // tasks already queued could still be printing parts of the value.
+    try {
+      opts.executor->add([chunks] { chunks->work(); });
+    } catch (...) {
+      break;
+    }
+  }
+
+  // Hand each chunk on as soon as it and those before it are done, so
+  // that a sink is written to while later chunks are still printing.
+  // Errors come out in the order serializing sequentially would have
+  // run into them.  The exceptions are released here rather than by a
+  // late executor task.
+  for (size_t i = 0; i < chunks->numChunks; ++i) {
+    chunks->await(i);
+    if (auto error = std::move(chunks->errors[i])) {
+      chunks->cancel();
+      chunks->errors.clear();
+      std::rethrow_exception(error);
+    }
+    try {
+      p.append(chunks->outputs[i]);
+    } catch (...) {
+      chunks->cancel();
+      chunks->errors.clear();
+      throw;
+    }
+    std::string().swap(chunks->outputs[i]);
+  }
+}
+
+// Print a top-level array or object the way p(dyn) would, splitting its
+// elements into chunks printed concurrently on opts.executor.
+void serializeParallel(
+    dynamic const& dyn,
+    Printer const& p,
+    serialization_opts const& opts) {
+  if (dyn.isArray()) {
+    std::vector<dynamic const*> elements;
+    elements.reserve(dyn.size());
+    for (auto& v : dyn) {
+      elements.push_back(&v);
+    }
+    p.openContainer('[');
+    printChunks(p, std::move(elements), opts);
+    p.closeContainer(']');
+  } else {
+    std::vector<SortedKeysCache::Item const*> elements;
+    if (!opts.sort_keys) {
+      elements.reserve(dyn.size());
+      for (auto& item : dyn.items()) {
+        elements.push_back(&item);
+      }
+    } else if (opts.sorted_keys_cache) {
+      opts.sorted_keys_cache->sortedItems(dyn, elements);
+    } else {
+      sortItems(dyn, elements);
+    }
+    p.openContainer('{');
+    printChunks(p, std::move(elements), opts);
+    p.closeContainer('}');
+  }
+}
+
   //////////////////////////////////////////////////////////////////////
 
   struct ParseError : std::runtime_error {
@@ -278,10 +517,11 @@ private:
 
 // Wraps our input buffer with some helper functions.
 struct Input {
-  explicit Input(StringPiece range, json::serialization_opts const* opts)
+  explicit Input(StringPiece range, json::serialization_opts const* opts,
+                 unsigned lineNum = 0)
       : range_(range)
       , opts_(*opts)
-      , lineNum_(0)
+      , lineNum_(lineNum)
   {
     storeCurrent();
   }
@@ -310,10 +550,52 @@ struct Input {
     return ret;
   }
 
+  // Equivalent to skipWhile(c != '"' && c != '\\'), but scans ahead a
+  // block at a time; control characters are the only other bytes the
+  // scanner stops at, and they are simply let through.
+  StringPiece skipStringChars() {
+    std::size_t skipped = 0;
+    for (;;) {
+      skipped += detail::qfind_json_special(
+          range_.subpiece(skipped), /* nonAscii = */ false);
+      if (skipped == range_.size()) {
+        break;
+      }
+      char const c = range_[skipped];
+      if (c == '\"' || c == '\\') {
+        break;
+      }
+      if (c == '\n') {
+        ++lineNum_;
+      }
+      ++skipped;
+    }
+    auto ret = range_.subpiece(0, skipped);
+    range_.advance(skipped);
+    storeCurrent();
+    return ret;
+  }
+
   StringPiece skipDigits() {
     return skipWhile([] (char c) { return c >= '0' && c <= '9'; });
   }
 
+  // Same as skipDigits(), additionally accumulating the digits into
+  // value.  Sets overflow, leaving value alone, once they stop fitting.
+  StringPiece skipDigits(uint64_t& value, bool& overflow) {
+    return skipWhile([&] (char c) {
+        if (c < '0' || c > '9') {
+          return false;
+        }
+        if (value > (std::numeric_limits<uint64_t>::max() - 9) / 10) {
+          overflow = true;
+        } else if (!overflow) {
+          value = value * 10 + (c - '0');
+        }
+        return true;
+      });
+  }
+
   StringPiece skipMinusAndDigits() {
     bool firstChar = true;
     return skipWhile([&firstChar] (char c) {
@@ -418,6 +700,7 @@ class RecursionGuard {
 };
 
 dynamic parseValue(Input& in);
+dynamic parseScalar(Input& in);
 std::string parseString(Input& in);
 dynamic parseNumber(Input& in);
 
@@ -494,6 +777,25 @@ dynamic parseArray(Input& in) {
   return ret;
 }
 
+// Clinger's fast path: a decimal mantissa of at most 53 bits times a
+// power of ten up to 1e22 is exact as a double, and so is their product
+// or quotient after the single rounding of the multiplication.
+bool decimalToDoubleFast(uint64_t mantissa, int64_t exponent, double& out) {
+  static constexpr double kPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+  };
+  constexpr int64_t kMaxExponent = sizeof(kPowersOfTen) / sizeof(double) - 1;
+
+  if (mantissa > (uint64_t(1) << 53) ||
+      exponent < -kMaxExponent || exponent > kMaxExponent) {
+    return false;
+  }
+  out = exponent < 0 ? double(mantissa) / kPowersOfTen[-exponent]
+                     : double(mantissa) * kPowersOfTen[exponent];
+  return true;
+}
+
 dynamic parseNumber(Input& in) {
   bool const negative = (*in == '-');
   if (negative && in.consume("-Infinity")) {
@@ -504,8 +806,17 @@ dynamic parseNumber(Input& in) {
     }
   }
 
-  auto integral = in.skipMinusAndDigits();
-  if (negative && integral.size() < 2) {
+  // Accumulate the mantissa while scanning, so that the common numbers
+  // need no second pass through to<>().
+  auto const numBegin = in.begin();
+  if (negative) {
+    ++in;
+  }
+  uint64_t mantissa = 0;
+  bool overflow = false;
+  auto const intDigits = in.skipDigits(mantissa, overflow);
+  auto const integral = range(numBegin, intDigits.end());
+  if (negative && intDigits.empty()) {
     in.error("expected digits after `-'");
   }
 
@@ -521,7 +832,13 @@ dynamic parseNumber(Input& in) {
   }
 
   if (*in != '.' && !wasE) {
-    if (LIKELY(!in.getOpts().double_fallback || integral.size() < maxIntLen) ||
+    // At most 18 digits, which always fit.
+    if (LIKELY(integral.size() < maxIntLen)) {
+      auto val = negative ? -int64_t(mantissa) : int64_t(mantissa);
+      in.skipWhitespace();
+      return val;
+    }
+    if (!in.getOpts().double_fallback ||
         (!negative && integral.size() == maxIntLen && integral <= maxInt) ||
         (negative && integral.size() == minIntLen && integral <= minInt)) {
       auto val = to<int64_t>(integral);
@@ -534,20 +851,45 @@ dynamic parseNumber(Input& in) {
     }
   }
 
-  auto end = !wasE ? (++in, in.skipDigits().end()) : in.begin();
+  // Digits after the point continue the mantissa, scaling the exponent.
+  bool wellFormed = true;
+  int64_t exponent = 0;
+  auto end = in.begin();
+  if (!wasE) {
+    ++in;
+    auto const fraction = in.skipDigits(mantissa, overflow);
+    wellFormed = !fraction.empty();
+    exponent = -int64_t(fraction.size());
+    end = fraction.end();
+  }
   if (*in == 'e' || *in == 'E') {
     ++in;
+    bool negativeExp = false;
     if (*in == '+' || *in == '-') {
+      negativeExp = *in == '-';
       ++in;
     }
-    auto expPart = in.skipDigits();
+    uint64_t expValue = 0;
+    bool expOverflow = false;
+    auto expPart = in.skipDigits(expValue, expOverflow);
     end = expPart.end();
+    if (expPart.empty() || expOverflow ||
+        expValue > uint64_t(std::numeric_limits<int32_t>::max())) {
+      wellFormed = false;
+    } else {
+      exponent += negativeExp ? -int64_t(expValue) : int64_t(expValue);
+    }
   }
   auto fullNum = range(integral.begin(), end);
   if (in.getOpts().parse_numbers_as_strings) {
     return fullNum;
   }
-  auto val = to<double>(fullNum);
+  double val;
+  if (wellFormed && !overflow &&
+      decimalToDoubleFast(mantissa, exponent, val)) {
+    return negative ? -val : val;
+  }
+  val = to<double>(fullNum);
   return val;
 }
 
@@ -599,15 +941,11 @@ std::string decodeUnicodeEscape(Input& in) {
   return codePointToUtf8(codePoint);
 }
 
-std::string parseString(Input& in) {
-  assert(*in == '\"');
-  ++in;
-
-  std::string ret;
+// Decodes the rest of a string literal whose opening quote has already
+// been consumed, appending it to ret.
+void decodeString(Input& in, std::string& ret) {
   for (;;) {
-    auto range = in.skipWhile(
-      [] (char c) { return c != '\"' && c != '\\'; }
-    );
+    auto range = in.skipStringChars();
     ret.append(range.begin(), range.end());
 
     if (*in == '\"') {
@@ -648,17 +986,19 @@ std::string parseString(Input& in) {
     ret.push_back(*in);
     ++in;
   }
+}
+
+std::string parseString(Input& in) {
+  assert(*in == '\"');
+  ++in;
 
+  std::string ret;
+  decodeString(in, ret);
   return ret;
 }
 
-dynamic parseValue(Input& in) {
-  RecursionGuard guard(in);
-
-  in.skipWhitespace();
-  return *in == '[' ? parseArray(in) :
-         *in == '{' ? parseObject(in) :
-         *in == '\"' ? parseString(in) :
+dynamic parseScalar(Input& in) {
+  return *in == '\"' ? parseString(in) :
          (*in == '-' || (*in >= '0' && *in <= '9')) ? parseNumber(in) :
          in.consume("true") ? true :
          in.consume("false") ? false :
@@ -672,95 +1012,722 @@ dynamic parseValue(Input& in) {
          in.error("expected json value");
 }
 
+dynamic parseValue(Input& in) {
+  RecursionGuard guard(in);
+
+  in.skipWhitespace();
+  return *in == '[' ? parseArray(in) :
+         *in == '{' ? parseObject(in) :
+         parseScalar(in);
 }
 
 //////////////////////////////////////////////////////////////////////
 
-std::string serialize(dynamic const& dyn, serialization_opts const& opts) {
-  std::string ret;
-  unsigned indentLevel = 0;
-  Printer p(ret, opts.pretty_formatting ? &indentLevel : nullptr, &opts);
-  p(dyn);
-  return ret;
+/*
+ * Event-driven counterparts of parseValue, parseObject and parseArray.
+ * They accept exactly the same input, but report what they find to a
+ * ParseHandler instead of building a dynamic.  Only object keys that
+ * are not strings (allow_non_string_keys) are still parsed as a tree.
+ */
+
+void parseEvents(Input& in, ParseHandler& handler);
+
+// Used for containers the handler asked to skip: accepts everything and
+// keeps descending, so that skipped input is still fully validated.
+ParseHandler& skipHandler() {
+  static ParseHandler handler;
+  return handler;
 }
 
-// Escape a string so that it is legal to print it in JSON text.
-void escapeString(
-    StringPiece input,
-    std::string& out,
-    const serialization_opts& opts) {
-  auto hexDigit = [] (int c) -> char {
-    return c < 10 ? c + '0' : c - 10 + 'a';
-  };
+void parseObjectEvents(Input& in, ParseHandler& handler) {
+  assert(*in == '{');
+  ++in;
 
-  out.push_back('\"');
+  in.skipWhitespace();
+  if (*in == '}') {
+    ++in;
+    handler.endObject();
+    return;
+  }
 
-  auto* p = reinterpret_cast<const unsigned char*>(input.begin());
-  auto* q = reinterpret_cast<const unsigned char*>(input.begin());
-  auto* e = reinterpret_cast<const unsigned char*>(input.end());
+  for (;;) {
+    if (in.getOpts().allow_trailing_comma && *in == '}') {
+      break;
+    }
+    if (*in == '\"') { // string
+      handler.key(parseString(in));
+    } else if (!in.getOpts().allow_non_string_keys) {
+      in.error("expected string for object key name");
+    } else {
+      handler.key(parseValue(in));
+    }
+    in.skipWhitespace();
+    in.expect(':');
+    in.skipWhitespace();
+    parseEvents(in, handler);
 
-  while (p < e) {
-    // Since non-ascii encoding inherently does utf8 validation
-    // we explicitly validate utf8 only if non-ascii encoding is disabled.
-    if ((opts.validate_utf8 || opts.skip_invalid_utf8)
-        && !opts.encode_non_ascii) {
-      // to achieve better spatial and temporal coherence
-      // we do utf8 validation progressively along with the
-      // string-escaping instead of two separate passes
+    in.skipWhitespace();
+    if (*in != ',') {
+      break;
+    }
+    ++in;
+    in.skipWhitespace();
+  }
+  in.expect('}');
+  handler.endObject();
+}
 
-      // as the encoding progresses, q will stay at or ahead of p
-      CHECK(q >= p);
+void parseArrayEvents(Input& in, ParseHandler& handler) {
+  assert(*in == '[');
+  ++in;
 
-      // as p catches up with q, move q forward
-      if (q == p) {
-        // calling utf8_decode has the side effect of
-        // checking that utf8 encodings are valid
-        char32_t v = decodeUtf8(q, e, opts.skip_invalid_utf8);
-        if (opts.skip_invalid_utf8 && v == U'\ufffd') {
-          out.append(u8"\ufffd");
-          p = q;
-          continue;
-        }
-      }
+  in.skipWhitespace();
+  if (*in == ']') {
+    ++in;
+    handler.endArray();
+    return;
+  }
+
+  for (;;) {
+    if (in.getOpts().allow_trailing_comma && *in == ']') {
+      break;
     }
-    if (opts.encode_non_ascii && (*p & 0x80)) {
-      // note that this if condition captures utf8 chars
-      // with value > 127, so size > 1 byte
-      char32_t v = decodeUtf8(p, e, opts.skip_invalid_utf8);
-      out.append("\\u");
-      out.push_back(hexDigit(v >> 12));
-      out.push_back(hexDigit((v >> 8) & 0x0f));
-      out.push_back(hexDigit((v >> 4) & 0x0f));
-      out.push_back(hexDigit(v & 0x0f));
-    } else if (*p == '\\' || *p == '\"') {
-      out.push_back('\\');
-      out.push_back(*p++);
-    } else if (*p <= 0x1f) {
-      switch (*p) {
-        case '\b': out.append("\\b"); p++; break;
-        case '\f': out.append("\\f"); p++; break;
-        case '\n': out.append("\\n"); p++; break;
-        case '\r': out.append("\\r"); p++; break;
-        case '\t': out.append("\\t"); p++; break;
-        default:
-          // note that this if condition captures non readable chars
-          // with value < 32, so size = 1 byte (e.g control chars).
-          out.append("\\u00");
-          out.push_back(hexDigit((*p & 0xf0) >> 4));
-          out.push_back(hexDigit(*p & 0xf));
-          p++;
-      }
-    } else {
-      out.push_back(*p++);
+    parseEvents(in, handler);
+    in.skipWhitespace();
+    if (*in != ',') {
+      break;
     }
+    ++in;
+    in.skipWhitespace();
   }
+  in.expect(']');
+  handler.endArray();
+}
 
-  out.push_back('\"');
+void parseEvents(Input& in, ParseHandler& handler) {
+  RecursionGuard guard(in);
+
+  in.skipWhitespace();
+  if (*in == '{') {
+    parseObjectEvents(
+        in, handler.startObject() ? handler : skipHandler());
+  } else if (*in == '[') {
+    parseArrayEvents(
+        in, handler.startArray() ? handler : skipHandler());
+  } else {
+    handler.value(parseScalar(in));
+  }
 }
 
-std::string stripComments(StringPiece jsonC) {
-  std::string result;
-  enum class State {
+// Numbers and the true/false/null/NaN/Infinity literals are made of
+// these; anything else ends them.
+bool isBareTokenChar(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.';
+}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+
+StreamParser::StreamParser(serialization_opts const& opts)
+    : opts_(opts),
+      tokenKind_(Token::None),
+      tokenLine_(0),
+      escaped_(false),
+      lineNum_(0) {}
+
+void StreamParser::feed(StringPiece chunk) {
+  while (!chunk.empty()) {
+    if (tokenKind_ != Token::None) {
+      if (!continueToken(chunk)) {
+        return;
+      }
+      continue;
+    }
+
+    char const c = chunk.front();
+    if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+      if (c == '\n') {
+        ++lineNum_;
+      }
+      chunk.pop_front();
+      continue;
+    }
+
+    auto const expect =
+        stack_.empty() ? Expect::Value : stack_.back().expect;
+    switch (expect) {
+    case Expect::Colon:
+      if (c != ':') {
+        error(chunk, "expected ':'");
+      }
+      chunk.pop_front();
+      stack_.back().expect = Expect::Value;
+      break;
+    case Expect::CommaOrEnd:
+      if (c == ',') {
+        chunk.pop_front();
+        auto& frame = stack_.back();
+        frame.expect = frame.value.isObject() ? Expect::Key : Expect::Value;
+        frame.first = false;
+      } else {
+        closeContainer(chunk);
+      }
+      break;
+    case Expect::Key:
+    case Expect::Value:
+      if (c == '}' || c == ']') {
+        closeContainer(chunk);
+        break;
+      }
+      if (expect == Expect::Key && c != '\"' &&
+          !opts_.allow_non_string_keys) {
+        error(chunk, "expected string for object key name");
+      }
+      if (stack_.size() > opts_.recursion_limit) {
+        error(chunk, "recursion limit exceeded");
+      }
+      if (c == '{') {
+        startContainer(chunk, dynamic::object, Expect::Key);
+      } else if (c == '[') {
+        startContainer(chunk, dynamic::array, Expect::Value);
+      } else if (c == '\"') {
+        startToken(chunk, Token::String);
+      } else if (isBareTokenChar(c)) {
+        startToken(chunk, Token::Bare);
+      } else {
+        error(chunk, "expected json value");
+      }
+      break;
+    }
+  }
+}
+
+void StreamParser::finish() {
+  if (tokenKind_ == Token::Bare) {
+    tokenKind_ = Token::None;
+    parseToken(token_);
+    token_.clear();
+  }
+  if (tokenKind_ == Token::String) {
+    error(StringPiece(), "unterminated string");
+  }
+  if (!stack_.empty()) {
+    error(StringPiece(), "unexpected end of input");
+  }
+}
+
+bool StreamParser::next(dynamic& value) {
+  if (values_.empty()) {
+    return false;
+  }
+  value = std::move(values_.front());
+  values_.pop_front();
+  return true;
+}
+
+void StreamParser::startToken(StringPiece& chunk, Token token) {
+  tokenKind_ = token;
+  tokenLine_ = lineNum_;
+  escaped_ = false;
+  continueToken(chunk);
+}
+
+// Returns true once the current token is complete (and parsed), false if
+// chunk ran out first, in which case the whole chunk has been buffered.
+bool StreamParser::continueToken(StringPiece& chunk) {
+  size_t len;
+  bool done = false;
+  if (tokenKind_ == Token::String) {
+    // Nothing buffered yet means chunk starts with the opening quote.
+    size_t const start = token_.empty() ? 1 : 0;
+    len = start + scanString(chunk.subpiece(start), done);
+  } else {
+    len = std::find_if_not(chunk.begin(), chunk.end(), isBareTokenChar) -
+          chunk.begin();
+    done = len < chunk.size();
+  }
+
+  if (!done) {
+    token_.append(chunk.begin(), chunk.end());
+    chunk.clear();
+    return false;
+  }
+
+  auto const text = chunk.subpiece(0, len);
+  chunk.advance(len);
+  tokenKind_ = Token::None;
+  if (token_.empty()) {
+    parseToken(text);
+  } else {
+    token_.append(text.begin(), text.end());
+    parseToken(token_);
+    token_.clear();
+  }
+  return true;
+}
+
+// Returns how much of data belongs to the string being scanned, setting
+// done if that includes the closing quote.
+size_t StreamParser::scanString(StringPiece data, bool& done) {
+  size_t i = 0;
+  if (escaped_ && !data.empty()) {
+    // The previous chunk ended with a backslash.
+    escaped_ = false;
+    i = 1;
+  }
+  while (i < data.size()) {
+    i += detail::qfind_json_special(data.subpiece(i), false);
+    if (i == data.size()) {
+      break;
+    }
+    char const c = data[i++];
+    if (c == '\"') {
+      done = true;
+      break;
+    }
+    if (c == '\\') {
+      if (i == data.size()) {
+        escaped_ = true;
+        break;
+      }
+      ++i;
+    } else if (c == '\n') {
+      ++lineNum_;
+    }
+  }
+  return i;
+}
+
+void StreamParser::parseToken(StringPiece text) {
+  Input in(text, &opts_, tokenLine_);
+  auto value = parseScalar(in);
+  if (in.size()) {
+    in.error("unexpected character after value");
+  }
+  deliver(std::move(value));
+}
+
+void StreamParser::startContainer(
+    StringPiece& chunk,
+    dynamic&& container,
+    Expect e) {
+  chunk.pop_front();
+  stack_.push_back(Frame{std::move(container), nullptr, e, true});
+}
+
+void StreamParser::closeContainer(StringPiece& chunk) {
+  if (stack_.empty()) {
+    error(chunk, "expected json value");
+  }
+  auto const& frame = stack_.back();
+  bool const isObject = frame.value.isObject();
+  if (frame.expect != Expect::CommaOrEnd) {
+    if (!frame.first && !opts_.allow_trailing_comma) {
+      error(chunk, isObject ? "expected string for object key name"
+                            : "expected json value");
+    }
+    if (frame.expect == Expect::Value && isObject) {
+      error(chunk, "expected json value");
+    }
+  }
+  if (chunk.front() != (isObject ? '}' : ']')) {
+    error(chunk, isObject ? "expected '}'" : "expected ']'");
+  }
+  chunk.pop_front();
+
+  auto value = std::move(stack_.back().value);
+  stack_.pop_back();
+  deliver(std::move(value));
+}
+
+void StreamParser::deliver(dynamic&& value) {
+  if (stack_.empty()) {
+    values_.push_back(std::move(value));
+    return;
+  }
+  auto& frame = stack_.back();
+  if (frame.expect == Expect::Key) {
+    frame.key = std::move(value);
+    frame.expect = Expect::Colon;
+  } else if (frame.value.isObject()) {
+    frame.value.insert(std::move(frame.key), std::move(value));
+    frame.expect = Expect::CommaOrEnd;
+  } else {
+    frame.value.push_back(std::move(value));
+    frame.expect = Expect::CommaOrEnd;
+  }
+}
+
+void StreamParser::error(StringPiece chunk, char const* what) const {
+  throw ParseError(lineNum_, chunk.subpiece(0, 16 /* arbitrary */).toString(),
+                   what);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Bounds the length of escapeString(s, out, opts), assuming the worst
+// escape for every byte that may need one.
+size_t escapedSizeUpperBound(StringPiece s, serialization_opts const& opts) {
+  const bool checkNonAscii =
+      opts.encode_non_ascii || opts.validate_utf8 || opts.skip_invalid_utf8;
+  size_t size = 2 + s.size();
+  for (size_t i = 0;; ++i) {
+    i += detail::qfind_json_special(s.subpiece(i), checkNonAscii);
+    if (i >= s.size()) {
+      break;
+    }
+    auto const c = static_cast<unsigned char>(s[i]);
+    if (c & 0x80) {
+      // A \uXXXX per encoded byte at worst, or a U+FFFD (three bytes)
+      // per invalid one.
+      size += opts.encode_non_ascii ? 5 : 2;
+    } else if (c == '\"' || c == '\\') {
+      size += 1;
+    } else {
+      size += 5;  // \u00XX
+    }
+  }
+  return size;
+}
+
+size_t doubleSizeUpperBound(double d, serialization_opts const& opts) {
+  using double_conversion::DoubleToStringConverter;
+  switch (opts.double_mode) {
+    case DoubleToStringConverter::SHORTEST:
+      return estimateSpaceNeeded(d);
+    case DoubleToStringConverter::FIXED:
+      // Sign, at most kMaxFixedDigitsBeforePoint digits, point and the
+      // requested digits.
+      return 2 + DoubleToStringConverter::kMaxFixedDigitsBeforePoint +
+        opts.double_num_digits;
+    default:
+      // Sign, "0." and up to six padding zeros before the digits, or
+      // their exponent ("e-308").
+      return 10 + opts.double_num_digits;
+  }
+}
+
+// indentLevel is the level v itself is printed at when pretty printing.
+size_t sizeUpperBound(
+    dynamic const& v,
+    serialization_opts const& opts,
+    unsigned indentLevel) {
+  switch (v.type()) {
+  case dynamic::NULLT:
+    return 4;
+  case dynamic::BOOL:
+    return 5;
+  case dynamic::INT64: {
+    auto const i = v.getInt();
+    return digits10(i < 0 ? 0 - uint64_t(i) : uint64_t(i)) + (i < 0);
+  }
+  case dynamic::DOUBLE:
+    return doubleSizeUpperBound(v.getDouble(), opts);
+  case dynamic::STRING:
+    return escapedSizeUpperBound(v.getString(), opts);
+  case dynamic::ARRAY:
+  case dynamic::OBJECT:
+    break;
+  }
+  if (v.empty()) {
+    return 2;
+  }
+
+  // Brackets and commas, and with pretty_formatting a newline plus
+  // indentation before every element and before the closing bracket.
+  size_t size = 2 + v.size() - 1;
+  if (opts.pretty_formatting) {
+    size += v.size() * (1 + 2 * (indentLevel + 1)) + 1 + 2 * indentLevel;
+  }
+  if (v.isArray()) {
+    for (auto& e : v) {
+      size += sizeUpperBound(e, opts, indentLevel + 1);
+    }
+  } else {
+    size += v.size() * (opts.pretty_formatting ? 3 : 1);
+    for (auto& item : v.items()) {
+      size += sizeUpperBound(item.first, opts, indentLevel + 1) +
+        sizeUpperBound(item.second, opts, indentLevel + 1);
+    }
+  }
+  return size;
+}
+
+void printTopLevel(
+    dynamic const& dyn,
+    Printer const& p,
+    serialization_opts const& opts) {
+  if (opts.executor && (dyn.isArray() || dyn.isObject()) &&
+      dyn.size() > std::max<size_t>(opts.parallel_chunk_size, 1)) {
+    serializeParallel(dyn, p, opts);
+  } else {
+    p(dyn);
+  }
+}
+
+}
+
+std::string serialize(dynamic const& dyn, serialization_opts const& opts) {
+  std::string ret;
+  if (opts.reserve_output) {
+    ret.reserve(serializedSizeUpperBound(dyn, opts));
+  }
+  unsigned indentLevel = 0;
+  Printer p(ret, opts.pretty_formatting ? &indentLevel : nullptr, &opts);
+  printTopLevel(dyn, p, opts);
+  return ret;
+}
+
+void SortedKeysCache::sortedItems(
+    dynamic const& object,
+    std::vector<Item const*>& items) {
+  items.clear();
+  items.reserve(object.size());
+  size_t keysHash = object.size();
+  for (auto& item : object.items()) {
+    items.push_back(&item);
+    keysHash = hash::hash_combine(keysHash, item.first.hash());
+  }
+
+  auto found = orders_.find(keysHash);
+  if (found != orders_.end() && found->second.keys.size() == items.size()) {
+    auto& order = found->second;
+    bool same = true;
+    for (size_t i = 0; same && i < items.size(); ++i) {
+      auto& key = items[i]->first;
+      same = key.type() == order.keys[i].type() && key == order.keys[i];
+    }
+    if (same) {
+      permute(items, order.sorted);
+      return;
+    }
+  }
+
+  Order order;
+  order.keys.reserve(items.size());
+  order.sorted.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    order.keys.push_back(items[i]->first);
+    order.sorted.push_back(i);
+  }
+  std::sort(
+      order.sorted.begin(),
+      order.sorted.end(),
+      [&] (size_t a, size_t b) { return *items[a] < *items[b]; });
+  permute(items, order.sorted);
+
+  if (orders_.size() >= capacity_) {
+    orders_.clear();
+  }
+  orders_[keysHash] = std::move(order);
+}
+
+void SortedKeysCache::permute(
+    std::vector<Item const*>& items,
+    std::vector<size_t> const& sorted) {
+  std::vector<Item const*> permuted;
+  permuted.reserve(items.size());
+  for (auto i : sorted) {
+    permuted.push_back(items[i]);
+  }
+  items.swap(permuted);
+}
+
+size_t serializedSizeUpperBound(
+    dynamic const& dyn,
+    serialization_opts const& opts) {
+  return sizeUpperBound(dyn, opts, 0);
+}
+
+void serialize(
+    dynamic const& dyn,
+    Sink& sink,
+    serialization_opts const& opts) {
+  std::string buffer;
+  buffer.reserve(Printer::kSinkBufferSize * 2);
+  unsigned indentLevel = 0;
+  Printer p(
+      buffer, opts.pretty_formatting ? &indentLevel : nullptr, &opts, &sink);
+  printTopLevel(dyn, p, opts);
+  p.flush();
+}
+
+void serializeCanonical(
+    dynamic const& dyn,
+    Sink& sink,
+    SortedKeysCache* cache) {
+  serialization_opts opts;
+  opts.sort_keys = true;
+  opts.sorted_keys_cache = cache;
+  serialize(dyn, sink, opts);
+}
+
+uint64_t canonicalHash(dynamic const& dyn, SortedKeysCache* cache) {
+  Fnv64Sink sink;
+  serializeCanonical(dyn, sink, cache);
+  return sink.hash();
+}
+
+void FdSink::write(StringPiece data) {
+  while (!data.empty()) {
+    auto n = ::write(fd_, data.data(), data.size());
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSystemError("folly::json::FdSink: write failed");
+    }
+    data.advance(n);
+  }
+}
+
+void FileSink::write(StringPiece data) {
+  if (fwrite(data.data(), 1, data.size(), file_) != data.size()) {
+    throwSystemError("folly::json::FileSink: fwrite failed");
+  }
+}
+
+void ChunkedSink::write(StringPiece data) {
+  while (!data.empty()) {
+    if (chunks_.empty() || chunks_.back().size() == chunkSize_) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(chunkSize_);
+    }
+    auto& chunk = chunks_.back();
+    auto n = std::min(data.size(), chunkSize_ - chunk.size());
+    chunk.append(data.data(), n);
+    data.advance(n);
+  }
+}
+
+size_t ChunkedSink::size() const {
+  size_t size = 0;
+  for (auto& chunk : chunks_) {
+    size += chunk.size();
+  }
+  return size;
+}
+
+Fnv64Sink::Fnv64Sink() : hash_(hash::FNV_64_HASH_START) {}
+
+void Fnv64Sink::write(StringPiece data) {
+  hash_ = hash::fnv64_buf(data.data(), data.size(), hash_);
+}
+
+std::vector<iovec> ChunkedSink::iovecs() const {
+  std::vector<iovec> iov;
+  iov.reserve(chunks_.size());
+  for (auto& chunk : chunks_) {
+    iov.push_back({const_cast<char*>(chunk.data()), chunk.size()});
+  }
+  return iov;
+}
+
+// Escape a string so that it is legal to print it in JSON text.
+void escapeString(
+    StringPiece input,
+    std::string& out,
+    const serialization_opts& opts) {
+  auto hexDigit = [] (int c) -> char {
+    return c < 10 ? c + '0' : c - 10 + 'a';
+  };
+
+  out.push_back('\"');
+
+  auto* p = reinterpret_cast<const unsigned char*>(input.begin());
+  auto* q = reinterpret_cast<const unsigned char*>(input.begin());
+  auto* e = reinterpret_cast<const unsigned char*>(input.end());
+
+  // Any byte above 0x7f has to go through the slow path below when we
+  // validate or encode utf8; otherwise only '\\', '"' and control
+  // characters need escaping.
+  const bool checkNonAscii =
+      opts.encode_non_ascii || opts.validate_utf8 || opts.skip_invalid_utf8;
+
+  while (p < e) {
+    // Copy the run of bytes that need no escaping with a single append.
+    auto run = detail::qfind_json_special(
+        StringPiece(reinterpret_cast<const char*>(p),
+                    reinterpret_cast<const char*>(e)),
+        checkNonAscii);
+    if (run) {
+      out.append(reinterpret_cast<const char*>(p), run);
+      p += run;
+      // Only ascii was skipped, so utf8 validation restarts from here.
+      if (q < p) {
+        q = p;
+      }
+      continue;
+    }
+
+    // Since non-ascii encoding inherently does utf8 validation
+    // we explicitly validate utf8 only if non-ascii encoding is disabled.
+    if ((opts.validate_utf8 || opts.skip_invalid_utf8)
+        && !opts.encode_non_ascii) {
+      // to achieve better spatial and temporal coherence
+      // we do utf8 validation progressively along with the
+      // string-escaping instead of two separate passes
+
+      // as the encoding progresses, q will stay at or ahead of p
+      CHECK(q >= p);
+
+      // as p catches up with q, move q forward
+      if (q == p) {
+        // calling utf8_decode has the side effect of
+        // checking that utf8 encodings are valid
+        char32_t v = decodeUtf8(q, e, opts.skip_invalid_utf8);
+        if (opts.skip_invalid_utf8 && v == U'\ufffd') {
+          out.append(u8"\ufffd");
+          p = q;
+          continue;
+        }
+      }
+    }
+    if (opts.encode_non_ascii && (*p & 0x80)) {
+      // note that this if condition captures utf8 chars
+      // with value > 127, so size > 1 byte
+      char32_t v = decodeUtf8(p, e, opts.skip_invalid_utf8);
+      const char escaped[] = {
+        '\\', 'u',
+        hexDigit(v >> 12), hexDigit((v >> 8) & 0x0f),
+        hexDigit((v >> 4) & 0x0f), hexDigit(v & 0x0f),
+      };
+      out.append(escaped, sizeof(escaped));
+    } else if (*p == '\\' || *p == '\"') {
+      out.push_back('\\');
+      out.push_back(*p++);
+    } else if (*p <= 0x1f) {
+      switch (*p) {
+        case '\b': out.append("\\b"); p++; break;
+        case '\f': out.append("\\f"); p++; break;
+        case '\n': out.append("\\n"); p++; break;
+        case '\r': out.append("\\r"); p++; break;
+        case '\t': out.append("\\t"); p++; break;
+        default:
+          // note that this if condition captures non readable chars
+          // with value < 32, so size = 1 byte (e.g control chars).
+          const char escaped[] = {
+            '\\', 'u', '0', '0',
+            hexDigit((*p & 0xf0) >> 4), hexDigit(*p & 0xf),
+          };
+          out.append(escaped, sizeof(escaped));
+          p++;
+      }
+    } else {
+      out.push_back(*p++);
+    }
+  }
+
+  out.push_back('\"');
+}
+
+std::string stripComments(StringPiece jsonC) {
+  std::string result;
+  enum class State {
     None,
     InString,
     InlineComment,
@@ -839,14 +1806,1150 @@ dynamic parseJson(
   return ret;
 }
 
-std::string toJson(dynamic const& dyn) {
-  return json::serialize(dyn, json::serialization_opts());
+#if FOLLY_DYNAMIC_ARENA
+
+ArenaDynamic parseJson(StringPiece range, SysArena& arena) {
+  return parseJson(range, arena, json::serialization_opts());
 }
 
-std::string toPrettyJson(dynamic const& dyn) {
-  json::serialization_opts opts;
-  opts.pretty_formatting = true;
-  return json::serialize(dyn, opts);
+ArenaDynamic parseJson(
+    StringPiece range,
+    SysArena& arena,
+    json::serialization_opts const& opts) {
+
+  detail::DynamicArenaScope scope(arena);
+  // Moving the result into the arena does not allocate: the containers
+  // are already there.
+  void* mem = arena.allocate(sizeof(dynamic));
+  return ArenaDynamic(arena, new (mem) dynamic(parseJson(range, opts)));
+}
+
+void ArenaDynamic::destroy() noexcept {
+  if (value_) {
+    // Frees long strings; the containers go away with the arena.
+    detail::DynamicArenaScope scope(*arena_);
+    value_->~dynamic();
+    value_ = nullptr;
+  }
+}
+
+#endif
+
+void parseJsonEvents(StringPiece range, json::ParseHandler& handler) {
+  parseJsonEvents(range, handler, json::serialization_opts());
+}
+
+void parseJsonEvents(
+    StringPiece range,
+    json::ParseHandler& handler,
+    json::serialization_opts const& opts) {
+
+  json::Input in(range, &opts);
+
+  parseEvents(in, handler);
+  in.skipWhitespace();
+  if (in.size() && *in != '\0') {
+    in.error("parsing didn't consume all input");
+  }
+}
+
+std::string toJson(dynamic const& dyn) {
+  return json::serialize(dyn, json::serialization_opts());
+}
+
+std::string toPrettyJson(dynamic const& dyn) {
+  json::serialization_opts opts;
+  opts.pretty_formatting = true;
+  return json::serialize(dyn, opts);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Builds the nodes of a JsonDocument in post-order: the nodes of the
+// container being parsed collect on pending_, and are moved to the
+// document in one piece once the container is closed, so that the
+// children of every node end up contiguous.
+struct JsonViewBuilder {
+  JsonViewBuilder(json::Input& in, JsonDocument& doc, JsonObjectLayout layout)
+      : in_(in), doc_(doc), layout_(layout) {}
+
+  static JsonDocument parse(
+      StringPiece range,
+      json::serialization_opts const& opts,
+      JsonObjectLayout layout) {
+    JsonDocument doc;
+    json::Input in(range, &opts);
+    JsonViewBuilder builder(in, doc, layout);
+
+    builder.parseValue();
+    in.skipWhitespace();
+    if (in.size() && *in != '\0') {
+      in.error("parsing didn't consume all input");
+    }
+    doc.nodes_.push_back(builder.pending_.back());
+
+    // The node vector won't grow anymore; turn child offsets into pointers.
+    for (auto& node : doc.nodes_) {
+      if (node.isArray() || node.isObject()) {
+        auto const index = node.childIndex_;
+        node.children_ = doc.nodes_.data() + index;
+      }
+    }
+    return doc;
+  }
+
+  void parseValue() {
+    json::RecursionGuard guard(in_);
+
+    in_.skipWhitespace();
+    if (*in_ == '[') {
+      parseArray();
+    } else if (*in_ == '{') {
+      parseObject();
+    } else if (*in_ == '\"') {
+      parseString();
+    } else {
+      parseScalar();
+    }
+  }
+
+  void parseObject() {
+    assert(*in_ == '{');
+    ++in_;
+
+    auto const mark = pending_.size();
+    in_.skipWhitespace();
+    if (*in_ == '}') {
+      ++in_;
+      closeContainer(dynamic::OBJECT, mark);
+      return;
+    }
+
+    for (;;) {
+      if (in_.getOpts().allow_trailing_comma && *in_ == '}') {
+        break;
+      }
+      if (*in_ == '\"') { // string
+        parseString();
+      } else if (!in_.getOpts().allow_non_string_keys) {
+        in_.error("expected string for object key name");
+      } else {
+        parseValue();
+      }
+      in_.skipWhitespace();
+      in_.expect(':');
+      in_.skipWhitespace();
+      parseValue();
+
+      in_.skipWhitespace();
+      if (*in_ != ',') {
+        break;
+      }
+      ++in_;
+      in_.skipWhitespace();
+    }
+    in_.expect('}');
+    if (layout_ == JsonObjectLayout::SharedKeys) {
+      closeSharedKeysObject(mark);
+    } else {
+      closeContainer(dynamic::OBJECT, mark);
+    }
+  }
+
+  void parseArray() {
+    assert(*in_ == '[');
+    ++in_;
+
+    auto const mark = pending_.size();
+    in_.skipWhitespace();
+    if (*in_ == ']') {
+      ++in_;
+      closeContainer(dynamic::ARRAY, mark);
+      return;
+    }
+
+    for (;;) {
+      if (in_.getOpts().allow_trailing_comma && *in_ == ']') {
+        break;
+      }
+      parseValue();
+      in_.skipWhitespace();
+      if (*in_ != ',') {
+        break;
+      }
+      ++in_;
+      in_.skipWhitespace();
+    }
+    in_.expect(']');
+    closeContainer(dynamic::ARRAY, mark);
+  }
+
+  // Strings without escapes are used in place, others are decoded into
+  // storage owned by the document.
+  void parseString() {
+    assert(*in_ == '\"');
+    ++in_;
+
+    auto str = in_.skipStringChars();
+    if (*in_ == '\"') {
+      ++in_;
+    } else {
+      doc_.strings_.emplace_back(str.begin(), str.end());
+      auto& decoded = doc_.strings_.back();
+      json::decodeString(in_, decoded);
+      str = decoded;
+    }
+
+    JsonView node;
+    node.type_ = dynamic::STRING;
+    node.size_ = str.size();
+    node.string_ = str.data();
+    pending_.push_back(node);
+  }
+
+  void parseScalar() {
+    auto const begin = in_.begin();
+    auto const value = json::parseScalar(in_);
+
+    JsonView node;
+    node.type_ = value.type();
+    switch (value.type()) {
+    case dynamic::BOOL:
+      node.boolean_ = value.getBool();
+      break;
+    case dynamic::INT64:
+      node.integer_ = value.getInt();
+      break;
+    case dynamic::DOUBLE:
+      node.double_ = value.getDouble();
+      break;
+    case dynamic::STRING:
+      // parse_numbers_as_strings: the value is the number's own text.
+      node.size_ = value.getString().size();
+      node.string_ = begin;
+      break;
+    default:
+      break;
+    }
+    pending_.push_back(node);
+  }
+
+  void closeContainer(dynamic::Type type, std::size_t mark) {
+    JsonView node;
+    node.type_ = type;
+    node.size_ = pending_.size() - mark;
+    node.childIndex_ = doc_.nodes_.size();
+    doc_.nodes_.insert(
+        doc_.nodes_.end(), pending_.begin() + mark, pending_.end());
+    pending_.erase(pending_.begin() + mark, pending_.end());
+    pending_.push_back(node);
+  }
+
+  // Like closeContainer(), but storing only the values, after a node
+  // pointing to the shape made of the keys.
+  void closeSharedKeysObject(std::size_t mark) {
+    // Keys and values are pending alternately.  Objects with non-string
+    // keys keep the inline layout.
+    signature_.clear();
+    for (auto i = mark; i < pending_.size(); i += 2) {
+      if (!pending_[i].isString()) {
+        closeContainer(dynamic::OBJECT, mark);
+        return;
+      }
+      auto const key = pending_[i].getString();
+      auto const size = static_cast<uint32_t>(key.size());
+      signature_.append(reinterpret_cast<char const*>(&size), sizeof(size));
+      signature_.append(key.data(), key.size());
+    }
+
+    auto& shape = shapes_[signature_];
+    if (!shape) {
+      doc_.shapes_.emplace_back();
+      shape = &doc_.shapes_.back();
+      for (auto i = mark; i < pending_.size(); i += 2) {
+        shape->keys.push_back(pending_[i]);
+      }
+      if (shape->keys.size() > kMaxShapeScan) {
+        for (std::size_t i = 0; i < shape->keys.size(); ++i) {
+          shape->index[shape->keys[i].getString()] = i;
+        }
+      }
+    }
+
+    JsonView header;
+    header.shape_ = shape;
+    doc_.nodes_.push_back(header);
+
+    JsonView node;
+    node.type_ = dynamic::OBJECT;
+    node.sharedKeys_ = true;
+    node.size_ = shape->keys.size();
+    node.childIndex_ = doc_.nodes_.size();
+    for (auto i = mark + 1; i < pending_.size(); i += 2) {
+      doc_.nodes_.push_back(pending_[i]);
+    }
+    pending_.erase(pending_.begin() + mark, pending_.end());
+    pending_.push_back(node);
+  }
+
+  // Shapes with more keys than this get an index for lookups.
+  static constexpr std::size_t kMaxShapeScan = 8;
+
+  json::Input& in_;
+  JsonDocument& doc_;
+  JsonObjectLayout const layout_;
+  std::vector<JsonView> pending_;
+  // Shapes by the length-prefixed concatenation of their keys.
+  std::unordered_map<std::string, JsonShape*> shapes_;
+  std::string signature_;
+};
+
+}
+
+JsonDocument parseJsonView(StringPiece range) {
+  return parseJsonView(range, json::serialization_opts());
+}
+
+JsonDocument parseJsonView(
+    StringPiece range,
+    json::serialization_opts const& opts,
+    JsonObjectLayout layout) {
+  return detail::JsonViewBuilder::parse(range, opts, layout);
+}
+
+void JsonView::requireType(Type type, char const* name) const {
+  if (type_ != type) {
+    throw TypeError(name, type_);
+  }
+}
+
+StringPiece JsonView::getString() const {
+  requireType(dynamic::STRING, "string");
+  return StringPiece(string_, size_);
+}
+
+double JsonView::getDouble() const {
+  requireType(dynamic::DOUBLE, "double");
+  return double_;
+}
+
+int64_t JsonView::getInt() const {
+  requireType(dynamic::INT64, "int64");
+  return integer_;
+}
+
+bool JsonView::getBool() const {
+  requireType(dynamic::BOOL, "boolean");
+  return boolean_;
+}
+
+std::size_t JsonView::size() const {
+  switch (type_) {
+  case dynamic::ARRAY:
+  case dynamic::STRING:
+    return size_;
+  case dynamic::OBJECT:
+    return sharedKeys_ ? size_ : size_ / 2;
+  default:
+    throw TypeError("array/object", type_);
+  }
+}
+
+bool JsonView::empty() const {
+  if (isNull()) {
+    return true;
+  }
+  return !size();
+}
+
+JsonView const* JsonView::begin() const {
+  requireType(dynamic::ARRAY, "array");
+  return children_;
+}
+
+JsonView const* JsonView::end() const {
+  requireType(dynamic::ARRAY, "array");
+  return children_ + size_;
+}
+
+JsonView const& JsonView::operator[](std::size_t index) const {
+  requireType(dynamic::ARRAY, "array");
+  if (index >= size_) {
+    std::__throw_out_of_range("out of range in JsonView array");
+  }
+  return children_[index];
+}
+
+JsonView const* JsonView::get_ptr(StringPiece key) const {
+  requireType(dynamic::OBJECT, "object");
+  if (sharedKeys_) {
+    auto const& shape = this->shape();
+    if (!shape.index.empty()) {
+      auto found = shape.index.find(key);
+      return found != shape.index.end() ? &children_[found->second] : nullptr;
+    }
+    for (auto i = size_; i != 0; --i) {
+      if (shape.keys[i - 1].getString() == key) {
+        return &children_[i - 1];
+      }
+    }
+    return nullptr;
+  }
+  for (auto i = size_; i != 0; i -= 2) {
+    auto const& k = children_[i - 2];
+    if (k.isString() && k.getString() == key) {
+      return &children_[i - 1];
+    }
+  }
+  return nullptr;
+}
+
+JsonView const& JsonView::operator[](StringPiece key) const {
+  if (auto* value = get_ptr(key)) {
+    return *value;
+  }
+  throw std::out_of_range(to<std::string>(
+      "couldn't find key ", key, " in JsonView object"));
+}
+
+JsonView const& JsonView::keyAt(std::size_t i) const {
+  requireType(dynamic::OBJECT, "object");
+  if (i >= size()) {
+    std::__throw_out_of_range("out of range in JsonView object");
+  }
+  return sharedKeys_ ? shape().keys[i] : children_[2 * i];
+}
+
+JsonView const& JsonView::valueAt(std::size_t i) const {
+  requireType(dynamic::OBJECT, "object");
+  if (i >= size()) {
+    std::__throw_out_of_range("out of range in JsonView object");
+  }
+  return sharedKeys_ ? children_[i] : children_[2 * i + 1];
+}
+
+dynamic JsonView::toDynamic() const {
+  switch (type_) {
+  case dynamic::NULLT:
+    return nullptr;
+  case dynamic::BOOL:
+    return boolean_;
+  case dynamic::INT64:
+    return integer_;
+  case dynamic::DOUBLE:
+    return double_;
+  case dynamic::STRING:
+    return getString();
+  case dynamic::ARRAY: {
+    dynamic ret = dynamic::array;
+    for (auto const& value : *this) {
+      ret.push_back(value.toDynamic());
+    }
+    return ret;
+  }
+  case dynamic::OBJECT: {
+    dynamic ret = dynamic::object;
+    for (std::size_t i = 0, n = size(); i < n; ++i) {
+      ret.insert(keyAt(i).toDynamic(), valueAt(i).toDynamic());
+    }
+    return ret;
+  }
+  }
+  CHECK(0) << "Bad type " << type_; abort();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// The first pass of LazyJson.  It accepts what StreamParser::feed()
+// does, for a single value in a single buffer, and records the values
+// on the tape instead of building them.
+struct LazyJsonScanner {
+  enum class Expect { Value, Key, Colon, CommaOrEnd };
+
+  struct Frame {
+    uint32_t entry;
+    Expect expect;
+    bool first;
+  };
+
+  explicit LazyJsonScanner(LazyJson& doc)
+      : text_(doc.text_), opts_(doc.opts_), tape_(doc.tape_) {}
+
+  void scan() {
+    if (text_.size() >= std::numeric_limits<uint32_t>::max()) {
+      throw json::ParseError("document too large");
+    }
+    while (pos_ < text_.size()) {
+      char const c = text_[pos_];
+      if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+        if (c == '\n') {
+          ++line_;
+        }
+        ++pos_;
+        continue;
+      }
+      if (done_) {
+        if (c != '\0') {
+          error("parsing didn't consume all input");
+        }
+        break;
+      }
+
+      auto const expect =
+          stack_.empty() ? Expect::Value : stack_.back().expect;
+      switch (expect) {
+      case Expect::Colon:
+        if (c != ':') {
+          error("expected ':'");
+        }
+        ++pos_;
+        stack_.back().expect = Expect::Value;
+        break;
+      case Expect::CommaOrEnd:
+        if (c == ',') {
+          ++pos_;
+          auto& frame = stack_.back();
+          frame.expect = isObject(frame) ? Expect::Key : Expect::Value;
+          frame.first = false;
+        } else {
+          closeContainer();
+        }
+        break;
+      case Expect::Key:
+      case Expect::Value:
+        if (c == '}' || c == ']') {
+          closeContainer();
+          break;
+        }
+        if (expect == Expect::Key && c != '\"' &&
+            !opts_.allow_non_string_keys) {
+          error("expected string for object key name");
+        }
+        if (stack_.size() > opts_.recursion_limit) {
+          error("recursion limit exceeded");
+        }
+        if (c == '{' || c == '[') {
+          stack_.push_back(
+              Frame{push(), c == '{' ? Expect::Key : Expect::Value, true});
+          ++pos_;
+        } else if (c == '\"') {
+          auto entry = push();
+          scanString(entry);
+          deliver(entry);
+        } else if (json::isBareTokenChar(c)) {
+          auto entry = push();
+          pos_ = std::find_if_not(
+                     text_.begin() + pos_, text_.end(), json::isBareTokenChar) -
+              text_.begin();
+          deliver(entry);
+        } else {
+          error("expected json value");
+        }
+        break;
+      }
+    }
+    if (!done_) {
+      error(stack_.empty() ? "expected json value" : "unexpected end of input");
+    }
+  }
+
+ private:
+  bool isObject(Frame const& frame) const {
+    return text_[tape_[frame.entry].begin] == '{';
+  }
+
+  uint32_t push() {
+    tape_.push_back(LazyJson::Entry{uint32_t(pos_), 0, 0, line_, 0});
+    return uint32_t(tape_.size() - 1);
+  }
+
+  void scanString(uint32_t entry) {
+    std::size_t i = pos_ + 1;
+    for (;;) {
+      i += qfind_json_special(text_.subpiece(i), false);
+      if (i == text_.size()) {
+        error("unterminated string");
+      }
+      char const c = text_[i++];
+      if (c == '\"') {
+        break;
+      }
+      if (c == '\\') {
+        if (i == text_.size()) {
+          error("unterminated string");
+        }
+        tape_[entry].size = 1;
+        ++i;
+      } else if (c == '\n') {
+        ++line_;
+      }
+    }
+    pos_ = i;
+  }
+
+  void closeContainer() {
+    if (stack_.empty()) {
+      error("expected json value");
+    }
+    auto const& frame = stack_.back();
+    bool const object = isObject(frame);
+    if (frame.expect != Expect::CommaOrEnd) {
+      if (!frame.first && !opts_.allow_trailing_comma) {
+        error(object ? "expected string for object key name"
+                     : "expected json value");
+      }
+      if (frame.expect == Expect::Value && object) {
+        error("expected json value");
+      }
+    }
+    if (text_[pos_] != (object ? '}' : ']')) {
+      error(object ? "expected '}'" : "expected ']'");
+    }
+    ++pos_;
+    auto const entry = frame.entry;
+    stack_.pop_back();
+    deliver(entry);
+  }
+
+  // The value at entry is complete.
+  void deliver(uint32_t entry) {
+    tape_[entry].end = uint32_t(pos_);
+    tape_[entry].next = uint32_t(tape_.size());
+    if (stack_.empty()) {
+      done_ = true;
+      return;
+    }
+    auto& frame = stack_.back();
+    if (frame.expect == Expect::Key) {
+      frame.expect = Expect::Colon;
+    } else {
+      ++tape_[frame.entry].size;
+      frame.expect = Expect::CommaOrEnd;
+    }
+  }
+
+  [[noreturn]] void error(char const* what) const {
+    throw json::ParseError(
+        line_, text_.subpiece(pos_, 16 /* arbitrary */).toString(), what);
+  }
+
+  StringPiece const text_;
+  json::serialization_opts const& opts_;
+  std::vector<LazyJson::Entry>& tape_;
+  std::vector<Frame> stack_;
+  std::size_t pos_ = 0;
+  uint32_t line_ = 0;
+  bool done_ = false;
+};
+
+}
+
+LazyJson::LazyJson(StringPiece json, json::serialization_opts const& opts)
+    : text_(json), opts_(opts) {
+  detail::LazyJsonScanner(*this).scan();
+}
+
+bool LazyJson::keyEquals(uint32_t index, StringPiece expected) const {
+  auto const& key = tape_[index];
+  if (text_[key.begin] != '\"') {
+    return false;
+  }
+  if (!key.size) {
+    return text_.subpiece(key.begin + 1, key.end - key.begin - 2) == expected;
+  }
+  // Keys with escapes are decoded once, into the cache.
+  return Ref(this, index).value().getString() == expected;
+}
+
+dynamic LazyJson::decode(Entry const& entry) const {
+  json::Input in(
+      text_.subpiece(entry.begin, entry.end - entry.begin), &opts_, entry.line);
+  auto ret = json::parseValue(in);
+  if (in.size()) {
+    in.error("unexpected character after value");
+  }
+  return ret;
+}
+
+bool LazyJson::Ref::isArray() const {
+  return doc_->text_[doc_->tape_[index_].begin] == '[';
+}
+
+bool LazyJson::Ref::isObject() const {
+  return doc_->text_[doc_->tape_[index_].begin] == '{';
+}
+
+dynamic::Type LazyJson::Ref::type() const {
+  return isArray() ? dynamic::ARRAY :
+         isObject() ? dynamic::OBJECT :
+         value().type();
+}
+
+void LazyJson::Ref::requireType(char bracket, char const* name) const {
+  if (doc_->text_[doc_->tape_[index_].begin] != bracket) {
+    throw TypeError(name, type());
+  }
+}
+
+std::size_t LazyJson::Ref::size() const {
+  if (!isArray() && !isObject()) {
+    throw TypeError("array/object", type());
+  }
+  return doc_->tape_[index_].size;
+}
+
+LazyJson::Ref LazyJson::Ref::operator[](std::size_t index) const {
+  requireType('[', "array");
+  auto const& tape = doc_->tape_;
+  if (index >= tape[index_].size) {
+    std::__throw_out_of_range("out of range in LazyJson array");
+  }
+  uint32_t i = index_ + 1;
+  for (; index; --index) {
+    i = tape[i].next;
+  }
+  return Ref(doc_, i);
+}
+
+Optional<LazyJson::Ref> LazyJson::Ref::get(StringPiece key) const {
+  requireType('{', "object");
+  auto const& tape = doc_->tape_;
+  Optional<Ref> found;
+  for (uint32_t i = index_ + 1; i < tape[index_].next;) {
+    auto const value = tape[i].next;
+    if (doc_->keyEquals(i, key)) {
+      found = Ref(doc_, value);
+    }
+    i = tape[value].next;
+  }
+  return found;
+}
+
+LazyJson::Ref LazyJson::Ref::operator[](StringPiece key) const {
+  if (auto value = get(key)) {
+    return *value;
+  }
+  throw std::out_of_range(to<std::string>(
+      "couldn't find key ", key, " in LazyJson object"));
+}
+
+dynamic const& LazyJson::Ref::value() const {
+  auto it = doc_->values_.find(index_);
+  if (it == doc_->values_.end()) {
+    it = doc_->values_
+             .emplace(index_, doc_->decode(doc_->tape_[index_]))
+             .first;
+  }
+  return it->second;
+}
+
+StringPiece LazyJson::Ref::raw() const {
+  auto const& entry = doc_->tape_[index_];
+  return doc_->text_.subpiece(entry.begin, entry.end - entry.begin);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Whether s is an array index as RFC 6901 spells them: no sign, and no
+// leading zeros.  Indexes too large for any array are not indexes.
+bool parseArrayIndex(StringPiece s, std::size_t& index) {
+  if (s.empty() || (s.size() > 1 && s[0] == '0')) {
+    return false;
+  }
+  std::size_t result = 0;
+  for (char c : s) {
+    if (c < '0' || c > '9' ||
+        result > (std::numeric_limits<std::size_t>::max() - 9) / 10) {
+      return false;
+    }
+    result = result * 10 + (c - '0');
+  }
+  index = result;
+  return true;
+}
+
+[[noreturn]] void throwPathError(StringPiece path,
+                                 StringPiece::const_iterator where,
+                                 char const* what) {
+  throw JsonPathError(to<std::string>(
+      "invalid path '", path, "' at offset ", where - path.begin(), ": ",
+      what));
+}
+
+}
+
+JsonPath JsonPath::fromPointer(StringPiece pointer) {
+  JsonPath path;
+  if (pointer.empty()) {
+    return path;
+  }
+  if (pointer[0] != '/') {
+    throwPathError(pointer, pointer.begin(), "a pointer starts with '/'");
+  }
+  auto p = pointer.begin() + 1;
+  std::string token;
+  for (;;) {
+    if (p == pointer.end() || *p == '/') {
+      path.addToken(Token::Kind::KeyOrIndex, std::move(token));
+      if (p == pointer.end()) {
+        break;
+      }
+      token.clear();
+    } else if (*p == '~') {
+      if (p + 1 == pointer.end() || (p[1] != '0' && p[1] != '1')) {
+        throwPathError(pointer, p, "'~' must be followed by '0' or '1'");
+      }
+      token.push_back(*++p == '0' ? '~' : '/');
+    } else {
+      token.push_back(*p);
+    }
+    ++p;
+  }
+  return path;
+}
+
+JsonPath JsonPath::fromJsonPath(StringPiece text) {
+  if (text.empty() || text[0] != '$') {
+    throwPathError(text, text.begin(), "a path starts with '$'");
+  }
+  JsonPath path;
+  auto p = text.begin() + 1;
+  while (p != text.end()) {
+    if (*p == '.') {
+      ++p;
+      if (p != text.end() && *p == '*') {
+        path.addToken(Token::Kind::Wildcard, std::string());
+        ++p;
+        continue;
+      }
+      if (p != text.end() && *p == '.') {
+        throwPathError(text, p, "recursive descent is not supported");
+      }
+      auto name = p;
+      while (p != text.end() && *p != '.' && *p != '[') {
+        ++p;
+      }
+      if (p == name) {
+        throwPathError(text, p, "expected a member name");
+      }
+      path.addToken(Token::Kind::Key, std::string(name, p));
+    } else if (*p == '[') {
+      ++p;
+      if (p == text.end()) {
+        throwPathError(text, p, "unterminated '['");
+      }
+      if (*p == '*') {
+        path.addToken(Token::Kind::Wildcard, std::string());
+        ++p;
+      } else if (*p == '\'' || *p == '"') {
+        char const quote = *p++;
+        std::string name;
+        while (p != text.end() && *p != quote) {
+          if (*p == '\\' && p + 1 != text.end()) {
+            ++p;
+          }
+          name.push_back(*p++);
+        }
+        if (p == text.end()) {
+          throwPathError(text, p, "unterminated string");
+        }
+        ++p;
+        path.addToken(Token::Kind::Key, std::move(name));
+      } else {
+        auto digits = p;
+        while (p != text.end() && *p >= '0' && *p <= '9') {
+          ++p;
+        }
+        std::size_t index;
+        if (!parseArrayIndex(StringPiece(digits, p), index)) {
+          throwPathError(text, digits, "expected an array index");
+        }
+        path.addToken(Token::Kind::Index, std::string());
+        path.tokens_.back().index = index;
+        path.tokens_.back().hasIndex = true;
+      }
+      if (p == text.end() || *p != ']') {
+        throwPathError(text, p, "expected ']'");
+      }
+      ++p;
+    } else {
+      throwPathError(text, p, "expected '.' or '['");
+    }
+  }
+  return path;
+}
+
+void JsonPath::addToken(Token::Kind kind, std::string&& key) {
+  Token token;
+  token.kind = kind;
+  token.hash = 0;
+  token.index = 0;
+  token.hasIndex = false;
+  if (kind == Token::Kind::Key || kind == Token::Kind::KeyOrIndex) {
+    if (kind == Token::Kind::KeyOrIndex) {
+      token.hasIndex = parseArrayIndex(key, token.index);
+    }
+    token.key = std::move(key);
+#if FOLLY_DYNAMIC_FLAT_OBJECTS
+    token.hash = detail::DynamicFlatHash()(token.key);
+#endif
+  }
+  tokens_.push_back(std::move(token));
+}
+
+bool JsonPath::hasWildcard() const {
+  for (auto const& token : tokens_) {
+    if (token.kind == Token::Kind::Wildcard) {
+      return true;
+    }
+  }
+  return false;
+}
+
+dynamic const* JsonPath::child(dynamic const& parent, Token const& token) {
+  switch (parent.type()) {
+  case dynamic::OBJECT: {
+    if (token.kind != Token::Kind::Key &&
+        token.kind != Token::Kind::KeyOrIndex) {
+      return nullptr;
+    }
+    auto const& obj = parent.get<dynamic::ObjectImpl>();
+#if FOLLY_DYNAMIC_FLAT_OBJECTS
+    auto it = obj.find(token.key, token.hash);
+#else
+    auto it = obj.find(token.key);
+#endif
+    return it == obj.end() ? nullptr : &it->second;
+  }
+  case dynamic::ARRAY: {
+    if (token.kind == Token::Kind::Key || !token.hasIndex) {
+      return nullptr;
+    }
+    auto const& arr = parent.get<dynamic::Array>();
+    return token.index < arr.size() ? &arr[token.index] : nullptr;
+  }
+  default:
+    return nullptr;
+  }
+}
+
+template <class D, class Fn>
+bool JsonPath::visit(D& node, std::size_t depth, Fn& fn) const {
+  if (depth == tokens_.size()) {
+    return fn(node);
+  }
+  // Containers are only unshared on the way to a mutable result.
+  if (!std::is_const<D>::value) {
+    const_cast<dynamic&>(node).unshare();
+  }
+  auto const& token = tokens_[depth];
+  if (token.kind != Token::Kind::Wildcard) {
+    auto next = const_cast<D*>(child(node, token));
+    return !next || visit(*next, depth + 1, fn);
+  }
+  if (node.isArray()) {
+    for (auto const& value : node) {
+      if (!visit(const_cast<D&>(value), depth + 1, fn)) {
+        return false;
+      }
+    }
+  } else if (node.isObject()) {
+    for (auto const& item : node.items()) {
+      if (!visit(const_cast<D&>(item.second), depth + 1, fn)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+dynamic const* JsonPath::get_ptr(dynamic const& root) const {
+  dynamic const* found = nullptr;
+  auto first = [&](dynamic const& value) {
+    found = &value;
+    return false;
+  };
+  visit(root, 0, first);
+  return found;
+}
+
+dynamic* JsonPath::get_ptr(dynamic& root) const {
+  dynamic* found = nullptr;
+  auto first = [&](dynamic& value) {
+    found = &value;
+    return false;
+  };
+  visit(root, 0, first);
+  return found;
+}
+
+std::vector<dynamic const*> JsonPath::select(dynamic const& root) const {
+  std::vector<dynamic const*> found;
+  auto all = [&](dynamic const& value) {
+    found.push_back(&value);
+    return true;
+  };
+  visit(root, 0, all);
+  return found;
+}
+
+namespace detail {
+
+// Follows a JsonPath through the events of parseJsonEvents().  The
+// containers on the way to a match are walked without being built, and
+// those off the path are skipped; only matching values are built.
+class JsonPathHandler : public json::ParseHandler {
+ public:
+  JsonPathHandler(std::vector<JsonPath::Token> const& tokens,
+                  std::vector<dynamic>& out)
+      : tokens_(tokens), out_(out) {}
+
+  bool startObject() override { return start(dynamic::object); }
+  bool startArray() override { return start(dynamic::array); }
+  void endObject() override { end(); }
+  void endArray() override { end(); }
+
+  void key(dynamic&& key) override {
+    if (!building_.empty()) {
+      building_.back().key = std::move(key);
+      return;
+    }
+    auto& walking = walking_.back();
+    auto const& token = tokens_[walking.depth];
+    walking.childMatches = token.kind == Kind::Wildcard ||
+        ((token.kind == Kind::Key || token.kind == Kind::KeyOrIndex) &&
+         key.isString() && key.getString() == token.key.getString());
+  }
+
+  void value(dynamic&& value) override {
+    std::size_t depth;
+    switch (classify(depth)) {
+    case Node::Build:
+      add(std::move(value));
+      break;
+    case Node::Match:
+      out_.push_back(std::move(value));
+      break;
+    case Node::Walk:
+    case Node::Skip:
+      // A scalar where the path goes on cannot match.
+      break;
+    }
+  }
+
+ private:
+  typedef JsonPath::Token::Kind Kind;
+
+  enum class Node {
+    // Off the path.
+    Skip,
+    // On the path, which goes on below it.
+    Walk,
+    // Where the path ends.
+    Match,
+    // Inside a match.
+    Build,
+  };
+
+  // A container on the path.  depth is the index of the token its
+  // children have to match.
+  struct Walking {
+    std::size_t depth;
+    bool isArray;
+    std::size_t index;
+    bool childMatches;
+  };
+
+  // A container inside a match, and the key of its pending member.
+  struct Building {
+    dynamic value;
+    dynamic key;
+  };
+
+  // What the value that starts now is.  Called exactly once per value.
+  Node classify(std::size_t& depth) {
+    if (!building_.empty()) {
+      return Node::Build;
+    }
+    depth = 0;
+    if (!walking_.empty()) {
+      auto& walking = walking_.back();
+      if (walking.isArray) {
+        auto const& token = tokens_[walking.depth];
+        walking.childMatches = token.kind == Kind::Wildcard ||
+            (token.kind != Kind::Key && token.hasIndex &&
+             token.index == walking.index);
+        ++walking.index;
+      }
+      if (!walking.childMatches) {
+        return Node::Skip;
+      }
+      depth = walking.depth + 1;
+    }
+    return depth == tokens_.size() ? Node::Match : Node::Walk;
+  }
+
+  bool start(dynamic&& container) {
+    bool const isArray = container.isArray();
+    std::size_t depth;
+    switch (classify(depth)) {
+    case Node::Skip:
+      return false;
+    case Node::Walk:
+      walking_.push_back(Walking{depth, isArray, 0, false});
+      return true;
+    case Node::Match:
+    case Node::Build:
+      building_.push_back(Building{std::move(container), nullptr});
+      return true;
+    }
+    return false;
+  }
+
+  void end() {
+    if (building_.empty()) {
+      walking_.pop_back();
+      return;
+    }
+    dynamic value = std::move(building_.back().value);
+    building_.pop_back();
+    if (building_.empty()) {
+      out_.push_back(std::move(value));
+    } else {
+      add(std::move(value));
+    }
+  }
+
+  void add(dynamic&& value) {
+    auto& parent = building_.back();
+    if (parent.value.isArray()) {
+      parent.value.push_back(std::move(value));
+    } else {
+      parent.value.insert(std::move(parent.key), std::move(value));
+    }
+  }
+
+  std::vector<JsonPath::Token> const& tokens_;
+  std::vector<dynamic>& out_;
+  std::vector<Walking> walking_;
+  std::vector<Building> building_;
+};
+
+}
+
+std::vector<dynamic> JsonPath::selectFromJson(
+    StringPiece json,
+    json::serialization_opts const& opts) const {
+  std::vector<dynamic> out;
+  detail::JsonPathHandler handler(tokens_, out);
+  parseJsonEvents(json, handler, opts);
+  return out;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -40,18 +40,27 @@
 
 #pragma once
 
+#include <cstdio>
+#include <deque>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <folly/dynamic.h>
 #include <folly/Range.h>
+#include <folly/portability/IOVec.h>
 
 namespace folly {
 
+class Executor;
+
 //////////////////////////////////////////////////////////////////////
 
 namespace json {
 
+  class SortedKeysCache;
+
   struct serialization_opts {
     explicit serialization_opts()
         : allow_non_string_keys(false),
@@ -67,7 +76,11 @@ namespace json {
           double_num_digits(0), // ignored when mode is SHORTEST
           double_fallback(false),
           parse_numbers_as_strings(false),
-          recursion_limit(100) {}
+          recursion_limit(100),
+          reserve_output(false),
+          sorted_keys_cache(nullptr),
+          executor(nullptr),
+          parallel_chunk_size(64) {}
 
     // If true, keys in an object can be non-strings.  (In strict
     // JSON, object keys must be strings.)  This is used by dynamic's
@@ -118,6 +131,167 @@ namespace json {
 
     // Recursion limit when parsing.
     unsigned int recursion_limit;
+
+    // If true, serialize() first walks the document to reserve
+    // serializedSizeUpperBound() bytes of output, instead of letting the
+    // string grow (and be copied) as it goes.  That extra pass pays off
+    // for large documents of long strings more than for many small
+    // values.
+    bool reserve_output;
+
+    // With sort_keys, reuse the key order of objects seen before instead
+    // of sorting them again.  See SortedKeysCache.
+    SortedKeysCache* sorted_keys_cache;
+
+    // If set, serialize() splits the elements of a top-level array or
+    // object into chunks of parallel_chunk_size, prints them on this
+    // executor as well as on the calling thread, and concatenates the
+    // results.  The output is the same as without an executor.  The
+    // calling thread blocks until all chunks are done; chunks the
+    // executor refuses are printed on the calling thread.  Each chunk is
+    // printed into a string of its own.  With a sink, it is written out
+    // as soon as it and the chunks before it are done, but chunks done
+    // ahead of their turn wait in memory, so the sink no longer bounds
+    // memory use.
+    Executor* executor;
+    size_t parallel_chunk_size;
+  };
+
+  /*
+   * Receives the structure of a json document from parseJsonEvents(),
+   * in document order, without a dynamic ever being built for it:
+   *
+   *   {"a": [1, "x"]}  =>  startObject() key("a") startArray()
+   *                        value(1) value("x") endArray() endObject()
+   *
+   * Strings, numbers, booleans and null are reported through value().
+   * Returning false from startObject() or startArray() skips that
+   * container: it is still checked for syntax errors, but none of its
+   * events (including the matching end event) are reported.
+   *
+   * Every callback defaults to doing nothing, so handlers only need to
+   * override the events they care about.
+   */
+  class ParseHandler {
+   public:
+    virtual ~ParseHandler() {}
+
+    virtual bool startObject() { return true; }
+    // Only a string, unless allow_non_string_keys is set.
+    virtual void key(dynamic&& /* key */) {}
+    virtual void endObject() {}
+
+    virtual bool startArray() { return true; }
+    virtual void endArray() {}
+
+    virtual void value(dynamic&& /* value */) {}
+  };
+
+  /*
+   * Incremental parser for json that arrives in pieces, e.g. from a
+   * socket.  Chunks may be split anywhere, even in the middle of a
+   * token; the document is built up as chunks arrive, and only a token
+   * that straddles two chunks is ever copied.  Any number of top-level
+   * values may follow each other, optionally separated by whitespace,
+   * which covers NDJSON and plain concatenated json streams.
+   *
+   *   json::StreamParser parser;
+   *   while (auto chunk = readSome()) {
+   *     parser.feed(chunk);
+   *     dynamic value;
+   *     while (parser.next(value)) {
+   *       handle(std::move(value));
+   *     }
+   *   }
+   *   parser.finish();
+   *
+   * Errors are reported as the ParseError parseJson() throws, but the
+   * message and line number are not always the ones parseJson() would
+   * give for the same text: line numbers here count every newline from
+   * the start of the stream, where parseJson() only counts those inside
+   * strings, and a misplaced bracket, comma or colon is described in the
+   * parser's own terms.  The parser is unusable after an error.
+   */
+  class StreamParser {
+   public:
+    explicit StreamParser(
+        serialization_opts const& opts = serialization_opts());
+
+    // Parse chunk, queueing every top-level value it completes.
+    void feed(StringPiece chunk);
+
+    // Signal the end of the stream.  This completes a trailing top-level
+    // number or literal that had no delimiter after it, and throws if the
+    // stream ended in the middle of a value.
+    void finish();
+
+    // Move the oldest completed top-level value into value.  Returns
+    // false if there is none.
+    bool next(dynamic& value);
+
+   private:
+    enum class Expect { Value, Key, Colon, CommaOrEnd };
+    enum class Token { None, String, Bare };
+
+    struct Frame {
+      dynamic value;
+      dynamic key;
+      Expect expect;
+      bool first;
+    };
+
+    void startToken(StringPiece& chunk, Token token);
+    bool continueToken(StringPiece& chunk);
+    size_t scanString(StringPiece data, bool& done);
+    void parseToken(StringPiece text);
+    void startContainer(StringPiece& chunk, dynamic&& container, Expect e);
+    void closeContainer(StringPiece& chunk);
+    void deliver(dynamic&& value);
+    [[noreturn]] void error(StringPiece chunk, char const* what) const;
+
+    serialization_opts const opts_;
+    std::vector<Frame> stack_;
+    std::deque<dynamic> values_;
+    std::string token_;
+    Token tokenKind_;
+    unsigned tokenLine_;
+    bool escaped_;
+    unsigned lineNum_;
+  };
+
+  /*
+   * Remembers the order sort_keys puts the keys of objects in, keyed by
+   * the keys in their iteration order.  Serializing the same objects
+   * again, or objects of the same shape (such as an array of records),
+   * then costs a comparison of the keys instead of a sort.
+   *
+   * Not thread safe; parallel serialization only uses it for the
+   * top-level object.  Forgets everything once it holds capacity
+   * orders.
+   */
+  class SortedKeysCache {
+   public:
+    typedef std::pair<dynamic const, dynamic> Item;
+
+    explicit SortedKeysCache(size_t capacity = 1024) : capacity_(capacity) {}
+
+    // Replace items with pointers to the items of object, sorted by key.
+    void sortedItems(dynamic const& object, std::vector<Item const*>& items);
+
+    void clear() { orders_.clear(); }
+
+   private:
+    struct Order {
+      std::vector<dynamic> keys;  // in iteration order
+      std::vector<size_t> sorted;  // indexes into keys
+    };
+
+    static void permute(
+        std::vector<Item const*>& items,
+        std::vector<size_t> const& sorted);
+
+    size_t capacity_;
+    std::unordered_map<size_t, Order> orders_;
   };
 
   /*
@@ -127,6 +301,102 @@ namespace json {
    */
   std::string serialize(dynamic const&, serialization_opts const&);
 
+  /*
+   * An upper bound of the length of serialize(dyn, opts), computed
+   * without producing the output.  Strings, doubles and booleans are
+   * counted at their longest possible encoding; everything else exactly.
+   */
+  size_t serializedSizeUpperBound(dynamic const&, serialization_opts const&);
+
+  /*
+   * Destination of serialized json that is written out as it is
+   * produced, rather than built up as one string.
+   */
+  class Sink {
+   public:
+    virtual ~Sink() {}
+
+    // Consume the next piece of output.  Throws to abort serialization.
+    virtual void write(StringPiece data) = 0;
+  };
+
+  // Writes to a file descriptor, which it does not own.
+  class FdSink : public Sink {
+   public:
+    explicit FdSink(int fd) : fd_(fd) {}
+    void write(StringPiece data) override;
+
+   private:
+    int fd_;
+  };
+
+  // Writes to a stdio stream, which it does not own.
+  class FileSink : public Sink {
+   public:
+    explicit FileSink(FILE* file) : file_(file) {}
+    void write(StringPiece data) override;
+
+   private:
+    FILE* file_;
+  };
+
+  // Collects the output in chunks of a fixed size, ready to be handed to
+  // writev() or a socket without ever being copied into one buffer.
+  class ChunkedSink : public Sink {
+   public:
+    explicit ChunkedSink(size_t chunkSize = 64 * 1024)
+        : chunkSize_(chunkSize) {}
+    void write(StringPiece data) override;
+
+    // Total number of bytes written.
+    size_t size() const;
+
+    // The chunks, valid until the next write.
+    std::vector<iovec> iovecs() const;
+
+   private:
+    size_t chunkSize_;
+    std::deque<std::string> chunks_;
+  };
+
+  // Feeds its input to hash::fnv64_buf().
+  class Fnv64Sink : public Sink {
+   public:
+    Fnv64Sink();
+    void write(StringPiece data) override;
+
+    uint64_t hash() const { return hash_; }
+
+   private:
+    uint64_t hash_;
+  };
+
+  /*
+   * Serialize to sink.  Output is passed on in pieces of a few kilobytes,
+   * between the elements of arrays and objects, so memory use does not
+   * grow with the size of the document (only with its largest string),
+   * unless opts.executor is set.
+   */
+  void serialize(dynamic const&, Sink& sink, serialization_opts const&);
+
+  /*
+   * The canonical form of a dynamic is its json serialization with
+   * sort_keys set and all other options at their defaults.  Two dynamics
+   * compare equal if and only if their canonical forms do, doubles and
+   * integers aside.
+   *
+   * serializeCanonical() writes it to any sink, say one feeding a hash
+   * function of choice; canonicalHash() streams it through fnv64 and
+   * equals hash::fnv64(serialize(dyn, opts)) for those options, without
+   * the string ever being built.  Pass a SortedKeysCache when hashing
+   * many documents of the same shape.
+   */
+  void serializeCanonical(
+      dynamic const&,
+      Sink& sink,
+      SortedKeysCache* cache = nullptr);
+  uint64_t canonicalHash(dynamic const&, SortedKeysCache* cache = nullptr);
+
   /*
    * Escape a string so that it is legal to print it in JSON text and
    * append the result to out.
@@ -152,6 +422,86 @@ namespace json {
 dynamic parseJson(StringPiece, json::serialization_opts const&);
 dynamic parseJson(StringPiece);
 
+#if FOLLY_DYNAMIC_ARENA
+
+/*
+ * A read-only dynamic whose arrays and objects live in a SysArena,
+ * as returned by the arena overloads of parseJson() below, which are
+ * only there in FOLLY_DYNAMIC_ARENA builds (see dynamic.h).
+ *
+ * Parsing into an arena replaces the many small allocations a document
+ * normally needs, and their individual deallocation, with a few large
+ * blocks that are released together with the arena.  Strings short
+ * enough for the small string optimization need no allocation anyway;
+ * longer ones are still allocated on the heap.
+ *
+ * The value is only accessible as const: growing one of its containers
+ * outside the arena would hand arena memory to the heap allocator.
+ * Copies of (parts of) it are ordinary heap-backed dynamics.  The arena
+ * must outlive the ArenaDynamic.
+ */
+class ArenaDynamic {
+ public:
+  ArenaDynamic(ArenaDynamic&& other) noexcept
+      : arena_(other.arena_), value_(other.value_) {
+    other.value_ = nullptr;
+  }
+  ArenaDynamic& operator=(ArenaDynamic&& other) noexcept {
+    if (this != &other) {
+      destroy();
+      arena_ = other.arena_;
+      value_ = other.value_;
+      other.value_ = nullptr;
+    }
+    return *this;
+  }
+  ArenaDynamic(ArenaDynamic const&) = delete;
+  ArenaDynamic& operator=(ArenaDynamic const&) = delete;
+
+  ~ArenaDynamic() {
+    destroy();
+  }
+
+  dynamic const& get() const { return *value_; }
+  dynamic const& operator*() const { return *value_; }
+  dynamic const* operator->() const { return value_; }
+
+ private:
+  friend ArenaDynamic parseJson(
+      StringPiece, SysArena&, json::serialization_opts const&);
+
+  ArenaDynamic(SysArena& arena, dynamic* value)
+      : arena_(&arena), value_(value) {}
+
+  void destroy() noexcept;
+
+  SysArena* arena_;
+  dynamic* value_;
+};
+
+/*
+ * Parse a json blob the same way parseJson() does, allocating the
+ * arrays and objects of the result from arena.
+ */
+ArenaDynamic parseJson(
+    StringPiece,
+    SysArena& arena,
+    json::serialization_opts const&);
+ArenaDynamic parseJson(StringPiece, SysArena& arena);
+
+#endif
+
+/*
+ * Parse a json blob the same way parseJson() does, but report it to
+ * handler as a sequence of events instead of producing a dynamic.
+ * Useful when only a few fields of a large document are needed.
+ */
+void parseJsonEvents(
+    StringPiece,
+    json::ParseHandler&,
+    json::serialization_opts const&);
+void parseJsonEvents(StringPiece, json::ParseHandler&);
+
 /*
  * Serialize a dynamic into a json string.
  */
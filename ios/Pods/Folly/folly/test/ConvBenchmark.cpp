@@ -0,0 +1,144 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Conv.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include <folly/Benchmark.h>
+#include <folly/Foreach.h>
+
+using namespace folly;
+
+// String to integer conversion, which digits_to() does eight digits at a
+// time once there are eight left.  The baselines convert a digit at a
+// time, in a plain loop and with strtoull().
+
+namespace {
+
+uint64_t handwrittenAtoi(const char* start, const char* end) {
+  auto const maxDigits = 19;
+  if (start == end || end - start > maxDigits) {
+    throw std::runtime_error("bad input");
+  }
+  uint64_t result = 0;
+  for (; start != end; ++start) {
+    auto const c = static_cast<unsigned>(*start) - '0';
+    if (c >= 10) {
+      throw std::runtime_error("bad input");
+    }
+    result = result * 10 + c;
+  }
+  return result;
+}
+
+StringPiece pc1 = "1234567890123456789";
+
+void handwrittenAtoiMeasure(unsigned int n, unsigned int digits) {
+  auto p = pc1.subpiece(pc1.size() - digits, digits);
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(handwrittenAtoi(p.begin(), p.end()));
+  }
+}
+
+void strtoullMeasure(unsigned int n, unsigned int digits) {
+  auto p = pc1.subpiece(pc1.size() - digits, digits);
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(strtoull(p.begin(), nullptr, 10));
+  }
+}
+
+void follyAtoiMeasure(unsigned int n, unsigned int digits) {
+  auto p = pc1.subpiece(pc1.size() - digits, digits);
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(to<uint64_t>(p.begin(), p.end()));
+  }
+}
+
+void follyAtoiSignedMeasure(unsigned int n, unsigned int digits) {
+  auto p = pc1.subpiece(pc1.size() - digits, digits);
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(to<int64_t>(p.begin(), p.end()));
+  }
+}
+
+// Parses a number off the front of a longer string, as json and
+// format strings do; the digits have to be found before they are
+// converted.
+void follyPrefixMeasure(unsigned int n, unsigned int digits) {
+  BenchmarkSuspender braces;
+  std::string s = pc1.subpiece(pc1.size() - digits, digits).str() + ",\"x\"";
+  braces.dismiss();
+  FOR_EACH_RANGE (i, 0, n) {
+    StringPiece p = s;
+    doNotOptimizeAway(to<uint64_t>(&p));
+  }
+}
+
+// Too many digits: the error comes from the length, before any
+// digits are converted.
+void follyOverflowMeasure(unsigned int n, unsigned int) {
+  StringPiece p = "123456789012345678901";
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(tryTo<uint64_t>(p).hasError());
+  }
+}
+
+}
+
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 1)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 1)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 1)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 1)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 1)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 4)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 4)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 4)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 4)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 4)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 8)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 8)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 8)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 8)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 8)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 12)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 12)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 12)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 12)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 12)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 16)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 16)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 16)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 16)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 16)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(handwrittenAtoiMeasure, 19)
+BENCHMARK_RELATIVE_PARAM(strtoullMeasure, 19)
+BENCHMARK_RELATIVE_PARAM(follyAtoiMeasure, 19)
+BENCHMARK_RELATIVE_PARAM(follyAtoiSignedMeasure, 19)
+BENCHMARK_RELATIVE_PARAM(follyPrefixMeasure, 19)
+BENCHMARK_RELATIVE_PARAM(follyOverflowMeasure, 21)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/dynamic.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Benchmark.h>
+#include <folly/Foreach.h>
+#include <folly/detail/FlatHashMap.h>
+#include <folly/json.h>
+
+using namespace folly;
+
+// Small objects, in the two layouts dynamic can store them in: the
+// default std::unordered_map, and the detail::FlatHashMap used with
+// FOLLY_DYNAMIC_FLAT_OBJECTS, which searches up to 8 keys without an
+// index.  The maps are compared side by side here.  The dynamic
+// benchmarks at the end measure whichever layout this file was built
+// with; build it with and without -DFOLLY_DYNAMIC_FLAT_OBJECTS=1 to
+// compare those.
+
+namespace {
+
+// What dynamic uses for flat objects, less the allocator.
+struct FlatHash {
+  uint64_t operator()(dynamic const& key) const {
+    if (key.isString()) {
+      auto& str = key.getString();
+      return detail::flatHashBytes(str.data(), str.size());
+    }
+    return hash::twang_mix64(key.hash());
+  }
+};
+
+struct FlatKeyEqual {
+  bool operator()(dynamic const& a, dynamic const& b) const {
+    return a.type() == b.type() && a == b;
+  }
+};
+
+typedef std::unordered_map<dynamic, dynamic> NodeMap;
+typedef detail::FlatHashMap<
+    dynamic,
+    dynamic,
+    FlatHash,
+    FlatKeyEqual,
+    std::allocator<std::pair<dynamic const, dynamic>>>
+    FlatMap;
+
+std::vector<dynamic> makeKeys(unsigned int size) {
+  static char const* const names[] = {
+      "id", "name", "type", "created_at", "updated_at", "owner", "tags",
+      "status", "url", "description", "count", "parent", "children",
+      "version", "flags", "score",
+  };
+  std::vector<dynamic> keys;
+  for (unsigned int i = 0; i < size; ++i) {
+    keys.emplace_back(names[i % 16]);
+  }
+  return keys;
+}
+
+template <class Map>
+Map makeMap(std::vector<dynamic> const& keys) {
+  Map map;
+  for (auto const& key : keys) {
+    map.emplace(key, 1);
+  }
+  return map;
+}
+
+template <class Map>
+void buildMeasure(unsigned int n, unsigned int size) {
+  std::vector<dynamic> keys;
+  BENCHMARK_SUSPEND {
+    keys = makeKeys(size);
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(makeMap<Map>(keys).size());
+  }
+}
+
+template <class Map>
+void findMeasure(unsigned int n, unsigned int size) {
+  std::vector<dynamic> keys;
+  Map map;
+  BENCHMARK_SUSPEND {
+    keys = makeKeys(size);
+    map = makeMap<Map>(keys);
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(map.find(keys[i % size]) != map.end());
+  }
+}
+
+template <class Map>
+void findMissMeasure(unsigned int n, unsigned int size) {
+  Map map;
+  dynamic const missing = "missing";
+  BENCHMARK_SUSPEND {
+    map = makeMap<Map>(makeKeys(size));
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(map.find(missing) != map.end());
+  }
+}
+
+template <class Map>
+void copyMeasure(unsigned int n, unsigned int size) {
+  Map map;
+  BENCHMARK_SUSPEND {
+    map = makeMap<Map>(makeKeys(size));
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    Map copy(map);
+    doNotOptimizeAway(copy.size());
+  }
+}
+
+void nodeBuild(unsigned int n, unsigned int size) {
+  buildMeasure<NodeMap>(n, size);
+}
+void flatBuild(unsigned int n, unsigned int size) {
+  buildMeasure<FlatMap>(n, size);
+}
+void nodeFind(unsigned int n, unsigned int size) {
+  findMeasure<NodeMap>(n, size);
+}
+void flatFind(unsigned int n, unsigned int size) {
+  findMeasure<FlatMap>(n, size);
+}
+void nodeFindMiss(unsigned int n, unsigned int size) {
+  findMissMeasure<NodeMap>(n, size);
+}
+void flatFindMiss(unsigned int n, unsigned int size) {
+  findMissMeasure<FlatMap>(n, size);
+}
+void nodeCopy(unsigned int n, unsigned int size) {
+  copyMeasure<NodeMap>(n, size);
+}
+void flatCopy(unsigned int n, unsigned int size) {
+  copyMeasure<FlatMap>(n, size);
+}
+
+// An array of records of size keys each, as json.
+std::string makeRecords(unsigned int size) {
+  dynamic records = dynamic::array;
+  auto keys = makeKeys(size);
+  for (int i = 0; i < 1000; ++i) {
+    dynamic record = dynamic::object;
+    for (auto const& key : keys) {
+      record[key] = i;
+    }
+    records.push_back(std::move(record));
+  }
+  return toJson(records);
+}
+
+void dynamicParse(unsigned int n, unsigned int size) {
+  std::string json;
+  BENCHMARK_SUSPEND {
+    json = makeRecords(size);
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(parseJson(json).size());
+  }
+}
+
+void dynamicCopy(unsigned int n, unsigned int size) {
+  dynamic records;
+  BENCHMARK_SUSPEND {
+    records = parseJson(makeRecords(size));
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    dynamic copy = records;
+    doNotOptimizeAway(copy.size());
+  }
+}
+
+void dynamicLookup(unsigned int n, unsigned int size) {
+  dynamic records;
+  std::vector<dynamic> keys;
+  BENCHMARK_SUSPEND {
+    records = parseJson(makeRecords(size));
+    keys = makeKeys(size);
+  }
+  FOR_EACH_RANGE (i, 0, n) {
+    doNotOptimizeAway(records[i % 1000].get_ptr(keys[i % size]));
+  }
+}
+
+}
+
+BENCHMARK_PARAM(nodeBuild, 2)
+BENCHMARK_RELATIVE_PARAM(flatBuild, 2)
+BENCHMARK_PARAM(nodeBuild, 4)
+BENCHMARK_RELATIVE_PARAM(flatBuild, 4)
+BENCHMARK_PARAM(nodeBuild, 8)
+BENCHMARK_RELATIVE_PARAM(flatBuild, 8)
+BENCHMARK_PARAM(nodeBuild, 16)
+BENCHMARK_RELATIVE_PARAM(flatBuild, 16)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(nodeFind, 2)
+BENCHMARK_RELATIVE_PARAM(flatFind, 2)
+BENCHMARK_PARAM(nodeFind, 4)
+BENCHMARK_RELATIVE_PARAM(flatFind, 4)
+BENCHMARK_PARAM(nodeFind, 8)
+BENCHMARK_RELATIVE_PARAM(flatFind, 8)
+BENCHMARK_PARAM(nodeFind, 16)
+BENCHMARK_RELATIVE_PARAM(flatFind, 16)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(nodeFindMiss, 4)
+BENCHMARK_RELATIVE_PARAM(flatFindMiss, 4)
+BENCHMARK_PARAM(nodeFindMiss, 16)
+BENCHMARK_RELATIVE_PARAM(flatFindMiss, 16)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(nodeCopy, 4)
+BENCHMARK_RELATIVE_PARAM(flatCopy, 4)
+BENCHMARK_PARAM(nodeCopy, 16)
+BENCHMARK_RELATIVE_PARAM(flatCopy, 16)
+BENCHMARK_DRAW_LINE()
+BENCHMARK_PARAM(dynamicParse, 4)
+BENCHMARK_PARAM(dynamicParse, 16)
+BENCHMARK_PARAM(dynamicCopy, 4)
+BENCHMARK_PARAM(dynamicCopy, 16)
+BENCHMARK_PARAM(dynamicLookup, 4)
+BENCHMARK_PARAM(dynamicLookup, 16)
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/DynamicBinary.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include <folly/json.h>
+#include <folly/portability/GTest.h>
+
+using folly::BinaryParseError;
+using folly::dynamic;
+using folly::parseBinary;
+using folly::toBinary;
+
+namespace {
+
+dynamic randomValue(std::mt19937& rng, unsigned depth);
+
+dynamic randomScalar(std::mt19937& rng) {
+  switch (rng() % 7) {
+  case 0:
+    return nullptr;
+  case 1:
+    return bool(rng() % 2);
+  case 2:
+    return int64_t(rng() % 200) - 50;
+  case 3:
+    return int64_t((uint64_t(rng()) << 32) | rng());
+  case 4:
+    return std::uniform_real_distribution<double>(-1e300, 1e300)(rng);
+  case 5:
+    return std::ldexp(double(rng()), int(rng() % 2000) - 1000);
+  default: {
+    std::string s(rng() % 40, '\0');
+    for (auto& c : s) {
+      c = char(rng());
+    }
+    return s;
+  }
+  }
+}
+
+dynamic randomKey(std::mt19937& rng) {
+  dynamic key;
+  do {
+    key = randomScalar(rng);
+  } while (key.isNull());
+  return key;
+}
+
+dynamic randomValue(std::mt19937& rng, unsigned depth) {
+  auto const kind = depth < 5 ? rng() % 4 : 0;
+  if (kind == 1) {
+    dynamic ret = dynamic::array;
+    for (auto n = rng() % 8; n; --n) {
+      ret.push_back(randomValue(rng, depth + 1));
+    }
+    return ret;
+  }
+  if (kind == 2) {
+    dynamic ret = dynamic::object;
+    for (auto n = rng() % 8; n; --n) {
+      ret.insert(randomKey(rng), randomValue(rng, depth + 1));
+    }
+    return ret;
+  }
+  return randomScalar(rng);
+}
+
+bool sameBits(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+}
+
+TEST(DynamicBinary, Scalars) {
+  for (auto const& v : {
+           dynamic(nullptr),
+           dynamic(true),
+           dynamic(false),
+           dynamic(0),
+           dynamic(127),
+           dynamic(128),
+           dynamic(-1),
+           dynamic(std::numeric_limits<int64_t>::min()),
+           dynamic(std::numeric_limits<int64_t>::max()),
+           dynamic(0.5),
+           dynamic(-0.0),
+           dynamic(std::numeric_limits<double>::infinity()),
+           dynamic(""),
+           dynamic(std::string("a\0b", 3)),
+       }) {
+    auto copy = parseBinary(toBinary(v));
+    EXPECT_EQ(v, copy);
+    EXPECT_EQ(v.type(), copy.type());
+  }
+  EXPECT_EQ(1, toBinary(dynamic(127)).size());
+  EXPECT_TRUE(std::signbit(parseBinary(toBinary(-0.0)).getDouble()));
+  EXPECT_TRUE(std::isnan(
+      parseBinary(toBinary(std::numeric_limits<double>::quiet_NaN()))
+          .getDouble()));
+}
+
+TEST(DynamicBinary, NonStringKeys) {
+  dynamic obj = dynamic::object(1, "one")(true, "yes")(2.5, "half");
+  EXPECT_EQ(obj, parseBinary(toBinary(obj)));
+}
+
+TEST(DynamicBinary, RandomRoundTrip) {
+  std::mt19937 rng(1234);
+  for (int i = 0; i < 2000; ++i) {
+    auto const value = randomValue(rng, 0);
+    auto const copy = parseBinary(toBinary(value));
+    EXPECT_EQ(value, copy);
+  }
+}
+
+TEST(DynamicBinary, RoundTripThroughJson) {
+  folly::json::serialization_opts opts;
+  opts.allow_non_string_keys = true;
+  opts.allow_nan_inf = true;
+  opts.double_fallback = true;
+  std::mt19937 rng(5678);
+  for (int i = 0; i < 2000; ++i) {
+    auto value = randomValue(rng, 0);
+    // Json only keeps string keys and valid utf-8, so go through it once
+    // and compare what parseJson() gives with its binary round trip.
+    std::string text;
+    try {
+      text = folly::json::serialize(value, opts);
+    } catch (std::exception const&) {
+      continue;
+    }
+    auto const parsed = folly::parseJson(text, opts);
+    EXPECT_EQ(parsed, parseBinary(toBinary(parsed)));
+  }
+}
+
+TEST(DynamicBinary, DoublesBitForBit) {
+  std::mt19937 rng(42);
+  for (int i = 0; i < 10000; ++i) {
+    uint64_t bits = (uint64_t(rng()) << 32) | rng();
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    EXPECT_TRUE(sameBits(d, parseBinary(toBinary(d)).getDouble()));
+  }
+}
+
+TEST(DynamicBinary, Malformed) {
+  auto bad = [](std::string const& bytes) {
+    EXPECT_THROW(parseBinary(bytes), BinaryParseError);
+  };
+  bad("");
+  bad(std::string("\x00\x00", 2));     // trailing bytes
+  bad("\x08");                         // unknown tag
+  bad("\x03");                         // missing varint
+  bad("\x03\x80");                     // truncated varint
+  bad("\x04\x00\x00");                 // truncated double
+  bad("\x05\x05" "abc");               // truncated string
+  bad("\x06\x7f\x80");                 // more elements than bytes
+  bad(std::string("\x07\x01\x00\x00", 4)); // null key
+  bad("\x07\x01\x06\x00\x80");         // array key
+  // A tenth varint byte may only contribute the top bit.
+  bad("\x03\xff\xff\xff\xff\xff\xff\xff\xff\xff\x02");
+  bad("\x03\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01");
+  EXPECT_EQ(
+      dynamic(std::numeric_limits<int64_t>::min()),
+      parseBinary("\x03\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01"));
+
+  std::string deep;
+  for (int i = 0; i < 200; ++i) {
+    deep += "\x06\x01";
+  }
+  deep += "\x80";
+  bad(deep);
+  EXPECT_NO_THROW(parseBinary(deep, 300));
+}
+
+TEST(DynamicBinary, CorruptedInput) {
+  // Every corruption of a valid encoding either decodes to something or
+  // throws BinaryParseError; none may crash or read out of bounds.
+  std::mt19937 rng(91011);
+  for (int i = 0; i < 2000; ++i) {
+    auto bytes = toBinary(randomValue(rng, 0));
+    switch (rng() % 3) {
+    case 0:
+      bytes[rng() % bytes.size()] = char(rng());
+      break;
+    case 1:
+      bytes.resize(rng() % bytes.size());
+      break;
+    default:
+      bytes.insert(rng() % (bytes.size() + 1), 1, char(rng()));
+      break;
+    }
+    try {
+      parseBinary(bytes);
+    } catch (BinaryParseError const&) {
+    }
+  }
+  for (int i = 0; i < 20000; ++i) {
+    std::string bytes(rng() % 24, '\0');
+    for (auto& c : bytes) {
+      c = char(rng());
+    }
+    try {
+      parseBinary(bytes);
+    } catch (BinaryParseError const&) {
+    }
+  }
+}
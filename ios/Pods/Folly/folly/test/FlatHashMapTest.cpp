@@ -0,0 +1,103 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/detail/FlatHashMap.h>
+
+#include <functional>
+#include <string>
+
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+#include <folly/portability/GTest.h>
+
+using folly::dynamic;
+
+namespace {
+
+struct StringHash {
+  uint64_t operator()(std::string const& key) const {
+    return folly::detail::flatHashBytes(key.data(), key.size());
+  }
+};
+
+typedef folly::detail::FlatHashMap<
+    std::string,
+    int,
+    StringHash,
+    std::equal_to<std::string>,
+    std::allocator<std::pair<std::string const, int>>>
+    Map;
+
+// A map whose items array is full, with no room for one more.
+Map fullMap(int size) {
+  Map map;
+  for (int i = 0; i < size; ++i) {
+    map.emplace(folly::to<std::string>(i), i);
+  }
+  return Map(map);
+}
+
+}
+
+// Emplacing a key that is already present must not move the items, so
+// iterators and references stay valid, and a key that refers to an item
+// of the map itself can be passed in.
+TEST(FlatHashMap, EmplaceExistingKeepsItems) {
+  // Linear search only (4), and with an index (16).
+  for (int size : {4, 16}) {
+    auto map = fullMap(size);
+    auto begin = map.begin();
+    for (auto& item : map) {
+      auto ret = map.emplace(item.first, -1);
+      EXPECT_FALSE(ret.second);
+      EXPECT_EQ(&item, ret.first);
+      ret.first->second += 100;
+    }
+    EXPECT_EQ(begin, map.begin());
+    EXPECT_EQ(size, map.size());
+    for (auto& item : map) {
+      EXPECT_EQ(folly::to<int>(item.first) + 100, item.second);
+    }
+
+    // A new key built from one of the items, while they move.
+    auto ret = map.emplace(map.begin()->first + "x", 7);
+    EXPECT_TRUE(ret.second);
+    EXPECT_EQ("0x", ret.first->first);
+    EXPECT_EQ(size + 1, map.size());
+    EXPECT_EQ(ret.first, map.find("0x"));
+    EXPECT_EQ(100, map.find("0")->second);
+  }
+}
+
+TEST(FlatHashMap, DynamicUpdateWhileIterating) {
+  dynamic full = dynamic::object("a", 1)("b", 2)("c", 3)("d", 4);
+  dynamic copy = full;
+  for (auto* obj : {&full, &copy}) {
+    for (auto& kv : obj->items()) {
+      (*obj)[kv.first] = kv.second.asInt() * 10;
+    }
+    EXPECT_EQ(dynamic(dynamic::object("a", 10)("b", 20)("c", 30)("d", 40)),
+              *obj);
+  }
+
+  // A copy's items array is exactly full.
+  dynamic c = full;
+  auto& r = c["b"];
+  c["a"] = 5;
+  r = 6;
+  EXPECT_EQ(dynamic(6), c["b"]);
+  EXPECT_EQ(dynamic(5), c["a"]);
+}
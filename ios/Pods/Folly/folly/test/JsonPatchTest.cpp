@@ -0,0 +1,64 @@
+/*
+ * Copyright 2016 Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/JsonPatch.h>
+
+#include <folly/json.h>
+#include <folly/portability/GTest.h>
+
+using folly::JsonPatchError;
+using folly::applyJsonPatch;
+using folly::dynamic;
+using folly::parseJson;
+
+TEST(JsonPatch, Move) {
+  auto doc = parseJson(R"({"a":1,"b":[1,2]})");
+  applyJsonPatch(doc, parseJson(R"([
+    {"op":"move","from":"/a","path":"/b/1"},
+    {"op":"move","from":"/b/0","path":"/b/-"}
+  ])"));
+  EXPECT_EQ(parseJson(R"({"b":[1,2,1]})"), doc);
+}
+
+// A move that cannot add the value where it is going leaves it where it
+// was, like any other failing operation.
+TEST(JsonPatch, FailedMoveKeepsValue) {
+  auto const before = parseJson(R"({"a":1,"b":[1,2]})");
+
+  auto doc = before;
+  EXPECT_THROW(
+      applyJsonPatch(
+          doc, parseJson(R"([{"op":"move","from":"/a","path":"/missing/x"}])")),
+      JsonPatchError);
+  EXPECT_EQ(before, doc);
+
+  doc = before;
+  EXPECT_THROW(
+      applyJsonPatch(
+          doc, parseJson(R"([{"op":"move","from":"/b/0","path":"/b/5"}])")),
+      JsonPatchError);
+  EXPECT_EQ(before, doc);
+
+  // The operations before the failing one stay applied.
+  doc = before;
+  EXPECT_THROW(
+      applyJsonPatch(doc, parseJson(R"([
+        {"op":"add","path":"/c","value":3},
+        {"op":"move","from":"/b/1","path":"/b/2"}
+      ])")),
+      JsonPatchError);
+  EXPECT_EQ(parseJson(R"({"a":1,"b":[1,2],"c":3})"), doc);
+}